@@ -0,0 +1,342 @@
+#include "../common/wifi-star-scenario.h"
+#include "../common/sweep-runner.h"
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TrabalhoRedesBench");
+
+// Mede o desempenho do próprio simulador em cada cenário: tempo de parede (montagem e execução),
+// eventos executados, eventos por segundo, pico de memória residente e tamanho das saídas.
+// Cada ponto roda num processo filho (SweepRunner), então o pico de RSS é só daquele ponto.
+
+// Um ponto do benchmark: cenário, número de clientes e escalonador de eventos
+struct BenchPoint
+{
+  std::string scenario;
+  uint32_t nSta;
+  std::string scheduler;
+
+  std::string Tag() const
+  {
+    return scenario + "_n" + std::to_string(nSta) + "_" + scheduler;
+  }
+
+  static std::string CsvHeader()
+  {
+    return "scenario,nSta,scheduler";
+  }
+
+  std::string CsvColumns() const
+  {
+    return scenario + "," + std::to_string(nSta) + "," + scheduler;
+  }
+};
+
+// Resultado de um ponto, na ordem das colunas do relatório
+struct BenchResult
+{
+  double buildS = 0;
+  double runS = 0;
+  double wallS = 0;
+  uint64_t events = 0;
+  double eventsPerS = 0;
+  long peakRssKb = 0;
+  uint64_t outputBytes = 0;
+
+  static std::string CsvHeader()
+  {
+    return "buildS,runS,wallS,events,eventsPerS,peakRssKb,outputBytes";
+  }
+};
+
+static uint64_t FileSize(const std::string &fileName)
+{
+  struct stat st;
+  return !fileName.empty() && stat(fileName.c_str(), &st) == 0 ? st.st_size : 0;
+}
+
+// Roda um ponto no processo atual e grava uma linha de resultado em partFile
+template <class Scenario>
+int RunBenchPoint(const WifiStarConfig &config, const std::string &partFile)
+{
+  typedef std::chrono::steady_clock Clock;
+  Scenario scenario(config);
+
+  Clock::time_point start = Clock::now();
+  scenario.Build();
+  Clock::time_point built = Clock::now();
+  scenario.Run();
+  Clock::time_point finished = Clock::now();
+
+  BenchResult result;
+  result.events = Simulator::GetEventCount();
+  scenario.Teardown();
+
+  result.buildS = std::chrono::duration<double>(built - start).count();
+  result.runS = std::chrono::duration<double>(finished - built).count();
+  result.wallS = result.buildS + result.runS;
+  result.eventsPerS = result.runS > 0 ? result.events / result.runS : 0.0;
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  result.peakRssKb = usage.ru_maxrss;
+  result.outputBytes = FileSize(config.flowMonitorFile) + FileSize(config.sampleFile) + FileSize(config.animFile);
+
+  std::ofstream out(partFile);
+  out << BenchResult::CsvHeader() << "\n"
+      << result.buildS << "," << result.runS << "," << result.wallS << "," << result.events << ","
+      << result.eventsPerS << "," << result.peakRssKb << "," << result.outputBytes << "\n";
+  return out ? 0 : 1;
+}
+
+// Cenários medidos: mesmas políticas e taxas dos programas em TCPconnection/, UDPconnection/
+// e TCPUDPconnection/ (estático/móvel x TCP/UDP/híbrido)
+struct BenchScenario
+{
+  const char *name;
+  void (*configure)(WifiStarConfig &config);
+  int (*run)(const WifiStarConfig &config, const std::string &partFile);
+};
+
+static void TcpStaticConfig(WifiStarConfig &config)
+{
+  config.dataRate = "5Mbps";
+  config.tcpPort = 50000;
+}
+
+static void TcpMobilityConfig(WifiStarConfig &config)
+{
+  config.dataRate = "50Mbps";
+  config.tcpPort = 5000;
+  config.speed = 2.0;
+}
+
+static void UdpStaticConfig(WifiStarConfig &config)
+{
+  config.dataRate = "5Mbps";
+  config.udpPort = 9;
+}
+
+static void UdpMobilityConfig(WifiStarConfig &config)
+{
+  config.dataRate = "1Mbps";
+  config.udpPort = 9;
+  config.speed = 1.0;
+}
+
+static void HybridStaticConfig(WifiStarConfig &config)
+{
+  config.dataRate = "5Mbps";
+  config.udpPort = 9;
+  config.tcpPort = 50000;
+}
+
+static void HybridMobilityConfig(WifiStarConfig &config)
+{
+  config.dataRate = "50Mbps";
+  config.tcpPort = 5000;
+  config.udpPort = 6000;
+  config.speed = 2.0;
+}
+
+static const BenchScenario BENCH_SCENARIOS[] = {
+  {"tcp-static", TcpStaticConfig,
+   RunBenchPoint<WifiStarScenario<GridMobility, OnOffTraffic<TcpTransport>>>},
+  {"tcp-mobility", TcpMobilityConfig,
+   RunBenchPoint<WifiStarScenario<CircleMobility<TangentialMotion>, OnOffTraffic<TcpTransport>>>},
+  {"udp-static", UdpStaticConfig,
+   RunBenchPoint<WifiStarScenario<GridMobility, OnOffTraffic<UdpTransport>>>},
+  {"udp-mobility", UdpMobilityConfig,
+   RunBenchPoint<WifiStarScenario<CircleMobility<RadialMotion>, OnOffTraffic<UdpTransport>>>},
+  {"hybrid-static", HybridStaticConfig,
+   RunBenchPoint<WifiStarScenario<GridMobility,
+                                  SplitTraffic<OnOffTraffic<UdpTransport>, BulkSendTraffic<TcpTransport>>>>},
+  {"hybrid-mobility", HybridMobilityConfig,
+   RunBenchPoint<WifiStarScenario<CircleMobility<TangentialMotion>,
+                                  SplitTraffic<OnOffTraffic<TcpTransport>, OnOffTraffic<UdpTransport>>>>},
+};
+
+static const BenchScenario *FindScenario(const std::string &name)
+{
+  for (const BenchScenario &scenario : BENCH_SCENARIOS) {
+    if (name == scenario.name) {
+      return &scenario;
+    }
+  }
+  return nullptr;
+}
+
+// Lê um relatório anterior: (cenário, nSta, escalonador) -> colunas pelo nome. Relatórios sem a
+// coluna do escalonador foram medidos com o padrão (map).
+typedef std::map<std::string, std::map<std::string, std::string>> BenchTable;
+
+static BenchTable ReadReport(const std::string &fileName)
+{
+  BenchTable table;
+  std::ifstream in(fileName);
+  std::string line;
+  if (!std::getline(in, line)) {
+    return table;
+  }
+  std::vector<std::string> header = SplitList(line);
+  while (std::getline(in, line)) {
+    std::vector<std::string> values = SplitList(line);
+    std::map<std::string, std::string> row;
+    for (size_t i = 0; i < header.size() && i < values.size(); i++) {
+      row[header[i]] = values[i];
+    }
+    if (row["scheduler"].empty()) {
+      row["scheduler"] = "map";
+    }
+    table[row["scenario"] + "_n" + row["nSta"] + "_" + row["scheduler"]] = row;
+  }
+  return table;
+}
+
+// Compara o relatório com a referência. Um ponto regride se o tempo de parede cresceu mais que
+// "tolerance" (fração) ou se a taxa de eventos caiu mais que isso. Retorna o número de regressões.
+static uint32_t CompareReports(const BenchTable &current, const BenchTable &baseline, double tolerance)
+{
+  uint32_t regressions = 0;
+  for (const auto &entry : current) {
+    auto base = baseline.find(entry.first);
+    if (base == baseline.end()) {
+      std::cout << entry.first << ": sem referência" << std::endl;
+      continue;
+    }
+    const std::map<std::string, std::string> &now = entry.second;
+    const std::map<std::string, std::string> &before = base->second;
+    double wall = std::atof(now.at("wallS").c_str());
+    double baseWall = std::atof(before.at("wallS").c_str());
+    double rate = std::atof(now.at("eventsPerS").c_str());
+    double baseRate = std::atof(before.at("eventsPerS").c_str());
+
+    bool slower = baseWall > 0 && wall > baseWall * (1 + tolerance);
+    bool fewerEvents = baseRate > 0 && rate < baseRate * (1 - tolerance);
+    if (slower || fewerEvents) {
+      regressions++;
+    }
+    std::cout << (slower || fewerEvents ? "REGRESSÃO " : "ok        ") << entry.first
+              << ": parede " << wall << " s (ref " << baseWall << " s), "
+              << rate << " eventos/s (ref " << baseRate << ")";
+    if (now.at("events") != before.at("events")) {
+      // Outro número de eventos indica mudança de modelo, não só de desempenho
+      std::cout << ", eventos " << now.at("events") << " (ref " << before.at("events") << ")";
+    }
+    std::cout << std::endl;
+  }
+  return regressions;
+}
+
+// Para cada cenário e número de clientes, o escalonador com mais eventos por segundo
+static void ReportBestSchedulers(const BenchTable &report, const std::string &fileName)
+{
+  std::map<std::string, std::pair<std::string, double>> best;
+  for (const auto &entry : report) {
+    const std::map<std::string, std::string> &row = entry.second;
+    std::string point = row.at("scenario") + "," + row.at("nSta");
+    double rate = std::atof(row.at("eventsPerS").c_str());
+    auto it = best.find(point);
+    if (it == best.end() || rate > it->second.second) {
+      best[point] = std::make_pair(row.at("scheduler"), rate);
+    }
+  }
+
+  std::ofstream out(fileName);
+  out << "scenario,nSta,bestScheduler,eventsPerS\n";
+  for (const auto &entry : best) {
+    out << entry.first << "," << entry.second.first << "," << entry.second.second << "\n";
+    std::cout << "Melhor escalonador para " << entry.first << ": " << entry.second.first << " ("
+              << entry.second.second << " eventos/s)" << std::endl;
+  }
+}
+
+int main (int argc, char *argv[])
+{
+  std::string scenarios = "all";
+  std::string sizes = "4,8,16,32,64,128";
+  std::string schedulers = "map";
+  std::string outDir = "bench-out";
+  std::string output = "bench.csv";
+  std::string baseline;
+  double tolerance = 0.10;
+  double simTime = 0.0;
+  uint32_t jobs = 1;
+
+  CommandLine cmd(__FILE__);
+  cmd.AddValue("scenarios", "Cenários separados por vírgula (ou all)", scenarios);
+  cmd.AddValue("sizes", "Números de clientes separados por vírgula", sizes);
+  cmd.AddValue("schedulers", "Escalonadores comparados (map,heap,list,calendar,ladder)", schedulers);
+  cmd.AddValue("outDir", "Diretório das saídas de cada ponto", outDir);
+  cmd.AddValue("output", "Relatório CSV", output);
+  cmd.AddValue("baseline", "Relatório de referência para detectar regressões", baseline);
+  cmd.AddValue("tolerance", "Variação aceita em relação à referência (fração)", tolerance);
+  cmd.AddValue("simTime", "Duração simulada em s (0 = a de cada cenário)", simTime);
+  cmd.AddValue("jobs", "Pontos em paralelo (1 evita que um ponto atrapalhe a medição do outro)", jobs);
+  cmd.Parse(argc, argv);
+
+  std::vector<BenchPoint> points;
+  std::vector<std::string> names;
+  if (scenarios == "all") {
+    for (const BenchScenario &scenario : BENCH_SCENARIOS) {
+      names.push_back(scenario.name);
+    }
+  } else {
+    names = SplitList(scenarios);
+  }
+  for (const std::string &name : names) {
+    NS_ABORT_MSG_UNLESS(FindScenario(name), "Cenário desconhecido: " << name);
+    for (const std::string &n : SplitList(sizes)) {
+      for (const std::string &scheduler : SplitList(schedulers)) {
+        points.push_back({name, static_cast<uint32_t>(std::stoul(n)), scheduler});
+      }
+    }
+  }
+
+  mkdir(outDir.c_str(), 0755);
+  auto partName = [&outDir](const BenchPoint &point) { return outDir + "/" + point.Tag() + ".csv"; };
+  RemoveParts(points, partName);
+
+  SweepRunner runner(jobs);
+  uint32_t failures = runner.Run(points, [&](const BenchPoint &point) {
+    const BenchScenario *scenario = FindScenario(point.scenario);
+    WifiStarConfig config;
+    scenario->configure(config);
+    config.nSta = point.nSta;
+    config.scheduler = point.scheduler;
+    if (simTime > 0) {
+      config.appStop = simTime;
+      config.simStop = simTime;
+    }
+    config.flowMonitorFile = outDir + "/" + point.Tag() + ".xml";
+    config.sampleFile = outDir + "/" + point.Tag() + "-samples.csv";
+    return scenario->run(config, partName(point));
+  });
+
+  MergeCsv(points, partName, output);
+  std::cout << "Relatório: " << output << " (" << points.size() - failures << "/" << points.size()
+            << " pontos)" << std::endl;
+
+  if (SplitList(schedulers).size() > 1) {
+    ReportBestSchedulers(ReadReport(output), WithSuffix(output, "-best"));
+  }
+
+  uint32_t regressions = 0;
+  if (!baseline.empty()) {
+    regressions = CompareReports(ReadReport(output), ReadReport(baseline), tolerance);
+    std::cout << regressions << " regressões" << std::endl;
+  }
+  return failures == 0 && regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+#include "../common/scenario-batch.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TrabalhoRedesCampus");
+
+int main (int argc, char *argv[])
+{
+  // Campus com 36 APs em grade 6 x 6 (120 m entre vizinhos, 600 m de lado) no mesmo canal, 8
+  // clientes estáticos por célula enviando UDP (OnOff de 1 Mbps) ao servidor na porta 9. O alcance
+  // pela sensibilidade padrão é de ~220 m, então cada quadro só visita as células da grade em volta
+  // do transmissor e os receptores do outro lado do campus são ignorados
+  WifiStarConfig config;
+  config.nCells = 36;
+  config.nSta = 8;
+  config.cellLayout = "campus";
+  config.cellSpacing = 120.0;
+  config.dataRate = "1Mbps";
+  config.packetSize = 1024;
+  config.udpPort = 9;
+  config.flowMonitorFile = "campus.xml";
+
+  // Valores padrão acima; qualquer um pode ser trocado pela linha de comando ou por --batch
+  typedef WifiStarScenario<GridMobility, OnOffTraffic<UdpTransport>> Scenario;
+  return RunScenarioMain<Scenario>(config, argc, argv);
+}
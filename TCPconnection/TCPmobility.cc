@@ -1,13 +1,4 @@
-#include "ns3/core-module.h"
-#include "ns3/network-module.h"
-#include "ns3/internet-module.h"
-#include "ns3/wifi-module.h"
-#include "ns3/mobility-module.h"
-#include "ns3/applications-module.h"
-#include "ns3/bridge-module.h"
-#include "ns3/flow-monitor-module.h"
-#include "ns3/point-to-point-module.h"
-#include <cmath>
+#include "../common/scenario-batch.h"
 
 using namespace ns3;
 
@@ -15,111 +6,17 @@ NS_LOG_COMPONENT_DEFINE("TrabalhoRedesTCP");
 
 int main (int argc, char *argv[])
 {
-  NodeContainer serverNode;
-  serverNode.Create(1);
-
-  NodeContainer apNode;
-  apNode.Create(1);
-
-  NodeContainer wifiStaNodes;
-  wifiStaNodes.Create(4);
-
-  YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
-  YansWifiPhyHelper phy = YansWifiPhyHelper();
-  phy.SetPcapDataLinkType(YansWifiPhyHelper::DLT_IEEE802_11);
-  phy.SetChannel(channel.Create());
-
-  WifiHelper wifi;
-  wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
-                               "DataMode", StringValue("HtMcs7"),
-                               "ControlMode", StringValue("HtMcs0"));
-
-  WifiMacHelper mac;
-  Ssid ssid = Ssid("EquipeX");
-
-  mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
-  NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
-
-  mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
-  NetDeviceContainer staDevices = wifi.Install(phy, mac, wifiStaNodes);
-
-  InternetStackHelper stack;
-  stack.Install(serverNode);
-  stack.Install(apNode);
-  stack.Install(wifiStaNodes);
-
-  Ptr<Ipv4> ipv4 = apNode.Get(0)->GetObject<Ipv4>();
-  ipv4->SetAttribute("IpForward", BooleanValue(true));
-
-  Ipv4AddressHelper address;
-  address.SetBase("192.168.0.0", "255.255.255.0");
-  Ipv4InterfaceContainer apInterface = address.Assign(apDevice);
-  Ipv4InterfaceContainer staInterfaces = address.Assign(staDevices);
-
-  PointToPointHelper p2p;
-  p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
-  p2p.SetChannelAttribute("Delay", StringValue("2ms"));
-  NetDeviceContainer p2pDevices = p2p.Install(apNode.Get(0), serverNode.Get(0));
-
-  Ipv4AddressHelper p2pAddress;
-  p2pAddress.SetBase("10.1.1.0", "255.255.255.0");
-  Ipv4InterfaceContainer p2pInterfaces = p2pAddress.Assign(p2pDevices);
-
-  MobilityHelper mobilityAp;
-  Ptr<ListPositionAllocator> posAllocAp = CreateObject<ListPositionAllocator>();
-  posAllocAp->Add(Vector(25.0, 25.0, 0.0));
-  mobilityAp.SetPositionAllocator(posAllocAp);
-  mobilityAp.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-  mobilityAp.Install(apNode);
-
-  MobilityHelper mobilitySta;
-  mobilitySta.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
-  mobilitySta.Install(wifiStaNodes);
-
-  double radius = 10.0;
-  double speed = 2.0;
-  double apX = 25.0, apY = 25.0;
-
-  for (uint32_t i = 0; i < wifiStaNodes.GetN(); i++) {
-    Ptr<Node> node = wifiStaNodes.Get(i);
-    Ptr<ConstantVelocityMobilityModel> mob = node->GetObject<ConstantVelocityMobilityModel>();
-    double angle = 2 * M_PI * i / wifiStaNodes.GetN(); 
-    double x = apX + radius * std::cos(angle);
-    double y = apY + radius * std::sin(angle);
-    mob->SetPosition(Vector(x, y, 0.0));
-    double dx = -std::sin(angle) * speed;
-    double dy = std::cos(angle) * speed;
-    mob->SetVelocity(Vector(dx, dy, 0.0));
-  }
-
-  uint16_t port = 5000;
-  Address serverAddress(InetSocketAddress(p2pInterfaces.GetAddress(1), port));
-
-  PacketSinkHelper sinkHelper("ns3::TcpSocketFactory", serverAddress);
-  ApplicationContainer serverApp = sinkHelper.Install(serverNode.Get(0));
-  serverApp.Start(Seconds(1.0));
-  serverApp.Stop(Seconds(30.0));
-
-  OnOffHelper onOff("ns3::TcpSocketFactory", serverAddress);
-  onOff.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1]"));
-  onOff.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
-  onOff.SetAttribute("DataRate", StringValue("50Mbps"));
-  onOff.SetAttribute("PacketSize", UintegerValue(1024));
-
-  ApplicationContainer clientApps = onOff.Install(wifiStaNodes);
-  clientApps.Start(Seconds(2.0));
-  clientApps.Stop(Seconds(30.0));
-
-  Ipv4GlobalRoutingHelper::PopulateRoutingTables();
-
-  FlowMonitorHelper flowHelper;
-  Ptr<FlowMonitor> flowMonitor = flowHelper.InstallAll();
-
-  Simulator::Stop(Seconds(40.0));
-  Simulator::Run();
-
-  flowMonitor->SerializeToXmlFile("TCP_mobility_4.xml", true, true);
-  Simulator::Destroy();
-
-  return 0;
+  // 4 clientes girando ao redor do AP (raio 10 m, 2 m/s) enviando TCP (OnOff de 50 Mbps)
+  WifiStarConfig config;
+  config.nSta = 4;
+  config.dataRate = "50Mbps";
+  config.packetSize = 1024;
+  config.tcpPort = 5000;
+  config.radius = 10.0;
+  config.speed = 2.0;
+  config.flowMonitorFile = "TCP_mobility_4.xml";
+
+  // Valores padrão acima; qualquer um pode ser trocado pela linha de comando ou por --batch
+  typedef WifiStarScenario<CircleMobility<TangentialMotion>, OnOffTraffic<TcpTransport>> Scenario;
+  return RunScenarioMain<Scenario>(config, argc, argv);
 }
@@ -1,142 +1,84 @@
-#include "ns3/core-module.h"
-#include "ns3/network-module.h"
-#include "ns3/internet-module.h"
-#include "ns3/wifi-module.h"
-#include "ns3/mobility-module.h"
-#include "ns3/applications-module.h"
-#include "ns3/bridge-module.h"
-#include "ns3/point-to-point-module.h"
-#include "ns3/flow-monitor-module.h"
-#include <fstream>
-#include <iomanip>
+#include "../common/wifi-star-scenario.h"
+#include "../common/flow-summary.h"
+#include "../common/sweep-runner.h"
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("TrabalhoRedes");
 
-void RunScenario(uint32_t numClients) {
-  // Criando o nó servidor (s0)
-  NodeContainer serverNode;
-  serverNode.Create(1);
-
-  // Criando o nó Access Point (AP) separadamente
-  NodeContainer apNode;
-  apNode.Create(1);
-
-  // Criando os clientes sem fio
-  NodeContainer wifiStaNodes;
-  wifiStaNodes.Create(numClients); // Número variável de clientes
-
-  // Configurando o canal Wi-Fi
-  YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
-  YansWifiPhyHelper phy = YansWifiPhyHelper();
-  phy.SetPcapDataLinkType(YansWifiPhyHelper::DLT_IEEE802_11);
-  phy.SetChannel(channel.Create());
-
-  // Configurando o dispositivo Wi-Fi
-  WifiHelper wifi;
-  wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode", StringValue("HtMcs7"), "ControlMode", StringValue("HtMcs0"));
-  
-  WifiMacHelper mac;
-  Ssid ssid = Ssid("EquipeX");
-  
-  // Configuração do AP
-  mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
-  NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
-
-  // Configuração dos clientes
-  mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
-  NetDeviceContainer staDevices = wifi.Install(phy, mac, wifiStaNodes);
-
-  // Instalando a pilha de Internet
-  InternetStackHelper stack;
-  stack.Install(serverNode);
-  stack.Install(apNode);
-  stack.Install(wifiStaNodes);
-
-  // Atribuindo endereços IP aos dispositivos Wi-Fi
-  Ipv4AddressHelper address;
-  address.SetBase("192.168.0.0", "255.255.255.0");
-  Ipv4InterfaceContainer apInterface = address.Assign(apDevice);
-  Ipv4InterfaceContainer staInterfaces = address.Assign(staDevices);
-
-  // Configurando o link ponto a ponto entre o AP e o Servidor
-  PointToPointHelper p2p;
-  p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
-  p2p.SetChannelAttribute("Delay", StringValue("2ms"));
-  NetDeviceContainer p2pDevices = p2p.Install(apNode.Get(0), serverNode.Get(0));
-
-  // Atribuindo endereços IP ao link ponto a ponto
-  Ipv4AddressHelper p2pAddress;
-  p2pAddress.SetBase("10.1.1.0", "255.255.255.0");
-  Ipv4InterfaceContainer p2pInterfaces = p2pAddress.Assign(p2pDevices);
-
-  // Configurando a mobilidade dos nós
-  MobilityHelper mobility;
-
-  // AP estático
-  mobility.SetPositionAllocator("ns3::GridPositionAllocator",
-                                "MinX", DoubleValue(0.0),
-                                "MinY", DoubleValue(0.0),
-                                "DeltaX", DoubleValue(5.0),
-                                "DeltaY", DoubleValue(10.0),
-                                "GridWidth", UintegerValue(3),
-                                "LayoutType", StringValue("RowFirst"));
-
-  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-  mobility.Install(apNode);
-
-  // Configurando a mobilidade dos clientes
-  mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
-                                "X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=50.0]"),
-                                "Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=50.0]"));
-
-  mobility.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
-                            "Bounds", RectangleValue(Rectangle(0, 50, 0, 50)),
-                            "Speed", StringValue("ns3::ConstantRandomVariable[Constant=5.0]"),
-                            "Distance", DoubleValue(10.0));
-  mobility.Install(wifiStaNodes);
-
-  // Aplicação UDP no servidor
-  UdpEchoServerHelper echoServer(9);
-  ApplicationContainer serverApp = echoServer.Install(serverNode.Get(0));
-  serverApp.Start(Seconds(1.0));
-  serverApp.Stop(Seconds(10.0));
-
-  // Aplicação UDP nos clientes
-  UdpEchoClientHelper echoClient(p2pInterfaces.GetAddress(1), 9); // Enviar para o servidor
-  echoClient.SetAttribute("MaxPackets", UintegerValue(1));
-  echoClient.SetAttribute("Interval", TimeValue(Seconds(1.0)));
-  echoClient.SetAttribute("PacketSize", UintegerValue(1024));
-
-  ApplicationContainer clientApps = echoClient.Install(wifiStaNodes);
-  clientApps.Start(Seconds(2.0));
-  clientApps.Stop(Seconds(10.0));
-
-  // Habilitar o roteamento no AP
-  Ipv4GlobalRoutingHelper::PopulateRoutingTables();
-
-  // Configurar o Flow Monitor
-  Ptr<FlowMonitor> flowMonitor;
-  FlowMonitorHelper flowHelper;
-  flowMonitor = flowHelper.InstallAll();
+// Monta, executa e resume uma rodada do cenário
+template <class Scenario>
+void RunPoint(const WifiStarConfig& config, const std::string& output) {
+  Scenario scenario(config);
+  scenario.Build();
+  scenario.Run();
+  WriteFlowCsv(scenario.GetFlowRecorder(), output + ".csv");
+  scenario.Teardown();
+}
 
-  // Iniciar a simulação
-  Simulator::Stop(Seconds(10.0));
-  Simulator::Run();
+void RunScenario(WifiStarConfig config, const SweepPoint& point, const std::string& output) {
+  // Cada ponto usa a sua própria rodada do gerador aleatório
+  RngSeedManager::SetRun(point.run);
 
-  flowMonitor->SerializeToXmlFile("udp_mobility_simulation_results.xml", true, true);
+  config.nSta = point.numClients; // Número variável de clientes
+  // Cada ponto escreve nos seus próprios arquivos, para que as rodadas não se sobrescrevam
+  config.AddOutputSuffix("_" + point.Tag());
+  config.flowMonitorFile = output + ".xml";
 
-  // Finalizar a simulação
-  Simulator::Destroy();
+  if (point.transport == "tcp") {
+    RunPoint<WifiStarScenario<RandomWalkMobility, BulkSendTraffic<TcpTransport>>>(config, output);
+  } else {
+    RunPoint<WifiStarScenario<RandomWalkMobility, UdpEchoTraffic>>(config, output);
+  }
 }
 
 int main(int argc, char *argv[]) {
-  
-  // Rodar cenários com diferentes números de clientes
-  for (uint32_t numClients : {4, 8, 16, 32}) {
-    RunScenario(numClients);
+  // Clientes em passeio aleatório (5 m/s) numa área de 50 x 50 m, AP fixo na origem
+  WifiStarConfig config;
+  config.packetSize = 1024;
+  config.udpPort = 9;
+  config.tcpPort = 9;
+  config.maxBytes = 1024; // TCP: a mesma carga do eco UDP (uma mensagem de 1024 bytes)
+  config.speed = 5.0;
+  config.appStop = 10.0;
+  config.simStop = 10.0;
+
+  std::string clients = "4,8,16,32";
+  std::string transports = "udp";
+  uint32_t runs = 1;
+  uint32_t jobs = 0;
+  std::string output = "udp_mobility_simulation_results";
+
+  CommandLine cmd(__FILE__);
+  config.AddToCommandLine(cmd);
+  cmd.AddValue("clients", "Lista de números de clientes (ex.: 4,8,16,32)", clients);
+  cmd.AddValue("transports", "Lista de transportes: udp (eco) e/ou tcp", transports);
+  cmd.AddValue("runs", "Número de rodadas (sementes) por ponto", runs);
+  cmd.AddValue("jobs", "Processos simultâneos (0 = um por núcleo)", jobs);
+  cmd.AddValue("output", "Prefixo dos arquivos de saída", output);
+  cmd.Parse(argc, argv);
+
+  // Um ponto por combinação de (clientes, semente, transporte)
+  std::vector<SweepPoint> points;
+  for (const std::string& n : SplitList(clients)) {
+    for (uint32_t run = 1; run <= runs; run++) {
+      for (const std::string& transport : SplitList(transports)) {
+        points.push_back({static_cast<uint32_t>(std::stoul(n)), run, transport});
+      }
+    }
   }
-  
-  return 0;
+
+  // Rodar os cenários em paralelo, um processo por ponto, sem restos de execuções anteriores
+  auto partName = [&output](const SweepPoint& point) { return output + "_" + point.Tag() + ".csv"; };
+  RemoveParts(points, partName);
+  SweepRunner runner(jobs);
+  uint32_t failures = runner.Run(points, [&config, &output](const SweepPoint& point) {
+    RunScenario(config, point, output + "_" + point.Tag());
+    return 0;
+  });
+
+  // Juntar os resultados de todos os pontos em um único CSV
+  MergeCsv(points, partName, output + "_sweep.csv");
+
+  return failures == 0 ? 0 : 1;
 }
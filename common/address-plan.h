@@ -0,0 +1,154 @@
+#ifndef ADDRESS_PLAN_H
+#define ADDRESS_PLAN_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ns3 {
+
+// Plano de endereços das células: a célula c recebe a c-ésima sub-rede Wi-Fi a partir de
+// wifiNetwork e a c-ésima sub-rede P2P a partir de p2pNetwork, em blocos consecutivos do tamanho
+// dado pelo prefixo de cada uma. Com wifiPrefix = 0 a sub-rede Wi-Fi é a menor que comporta os
+// clientes e o AP, mas nunca menor que /24 (até 253 clientes o plano é o de sempre: 192.168.c.0/24
+// e 10.1.(c+1).0/24). Com IPv6, cada célula recebe ainda um /64 Wi-Fi (2001:db8:1:c::/64) e um P2P
+// (2001:db8:2:c::/64).
+class AddressPlan
+{
+public:
+  AddressPlan()
+    : m_wifiPrefix(24),
+      m_p2pPrefix(24)
+  {
+  }
+
+  AddressPlan(Ipv4Address wifiNetwork, uint32_t wifiPrefix, Ipv4Address p2pNetwork, uint32_t p2pPrefix,
+              uint32_t nCells, uint32_t nSta)
+    : m_wifiNetwork(wifiNetwork),
+      m_wifiPrefix(wifiPrefix == 0 ? std::min<uint32_t>(24, PrefixFor(nSta + 1)) : wifiPrefix),
+      m_p2pNetwork(p2pNetwork),
+      m_p2pPrefix(p2pPrefix)
+  {
+    NS_ABORT_MSG_UNLESS(m_wifiPrefix >= 8 && m_wifiPrefix <= PrefixFor(nSta + 1),
+                        "A sub-rede Wi-Fi /" << m_wifiPrefix << " não comporta " << nSta << " clientes e o AP");
+    NS_ABORT_MSG_UNLESS(m_p2pPrefix >= 8 && m_p2pPrefix <= 30, "Prefixo P2P inválido: /" << m_p2pPrefix);
+    CheckRange(m_wifiNetwork, m_wifiPrefix, nCells, "Wi-Fi");
+    CheckRange(m_p2pNetwork, m_p2pPrefix, nCells, "P2P");
+  }
+
+  // Maior prefixo (menor sub-rede) com "hosts" endereços além do de rede e do de broadcast
+  static uint32_t PrefixFor(uint32_t hosts)
+  {
+    uint32_t prefix = 30;
+    while (prefix > 0 && (uint64_t(1) << (32 - prefix)) - 2 < hosts) {
+      prefix--;
+    }
+    return prefix;
+  }
+
+  Ipv4Address WifiNetwork(uint32_t cell) const
+  {
+    return Ipv4Address(m_wifiNetwork.Get() + cell * BlockSize(m_wifiPrefix));
+  }
+
+  Ipv4Mask WifiMask() const
+  {
+    return MaskOf(m_wifiPrefix);
+  }
+
+  Ipv4Address P2pNetwork(uint32_t cell) const
+  {
+    return Ipv4Address(m_p2pNetwork.Get() + cell * BlockSize(m_p2pPrefix));
+  }
+
+  Ipv4Mask P2pMask() const
+  {
+    return MaskOf(m_p2pPrefix);
+  }
+
+  Ipv6Address WifiNetwork6(uint32_t cell) const
+  {
+    return Network6(1, cell);
+  }
+
+  Ipv6Address P2pNetwork6(uint32_t cell) const
+  {
+    return Network6(2, cell);
+  }
+
+  Ipv6Prefix Prefix6() const
+  {
+    return Ipv6Prefix(64);
+  }
+
+  // Entrada permanente no cache ARP da interface IPv4 de "device" para o par (endereço, MAC). Não
+  // faz nada em dispositivos sem ARP (P2P)
+  static void AddArpEntry(Ptr<NetDevice> device, Ipv4Address address, const Address &mac)
+  {
+    if (!device->NeedsArp()) {
+      return;
+    }
+    Ptr<Ipv4L3Protocol> ipv4 = device->GetNode()->GetObject<Ipv4L3Protocol>();
+    Ptr<ArpCache> cache = ipv4->GetInterface(ipv4->GetInterfaceForDevice(device))->GetArpCache();
+    ArpCache::Entry *entry = cache->Lookup(address);
+    if (!entry) {
+      entry = cache->Add(address);
+    }
+    entry->SetMacAddress(mac);
+    entry->MarkAutoGenerated();
+  }
+
+  // O mesmo no cache de vizinhos (NDISC) da interface IPv6
+  static void AddNdiscEntry(Ptr<NetDevice> device, Ipv6Address address, const Address &mac)
+  {
+    if (!device->NeedsArp()) {
+      return;
+    }
+    Ptr<Ipv6L3Protocol> ipv6 = device->GetNode()->GetObject<Ipv6L3Protocol>();
+    Ptr<NdiscCache> cache = ipv6->GetInterface(ipv6->GetInterfaceForDevice(device))->GetNdiscCache();
+    NdiscCache::Entry *entry = cache->Lookup(address);
+    if (!entry) {
+      entry = cache->Add(address);
+    }
+    entry->SetMacAddress(mac);
+    entry->MarkAutoGenerated();
+  }
+
+private:
+  static uint64_t BlockSize(uint32_t prefix)
+  {
+    return uint64_t(1) << (32 - prefix);
+  }
+
+  static Ipv4Mask MaskOf(uint32_t prefix)
+  {
+    return Ipv4Mask(static_cast<uint32_t>(~(BlockSize(prefix) - 1)));
+  }
+
+  static void CheckRange(Ipv4Address network, uint32_t prefix, uint32_t nCells, const char *name)
+  {
+    NS_ABORT_MSG_UNLESS((network.Get() & (BlockSize(prefix) - 1)) == 0,
+                        "A base " << network << " não é início de uma sub-rede " << name << " /" << prefix);
+    NS_ABORT_MSG_UNLESS(network.Get() + nCells * BlockSize(prefix) <= (uint64_t(1) << 32),
+                        nCells << " sub-redes " << name << " /" << prefix << " não cabem a partir de " << network);
+  }
+
+  static Ipv6Address Network6(uint8_t kind, uint32_t cell)
+  {
+    uint8_t bytes[16] = {0x20, 0x01, 0x0d, 0xb8, 0x00, kind, static_cast<uint8_t>(cell >> 8),
+                         static_cast<uint8_t>(cell)};
+    return Ipv6Address(bytes);
+  }
+
+  Ipv4Address m_wifiNetwork;
+  uint32_t m_wifiPrefix;
+  Ipv4Address m_p2pNetwork;
+  uint32_t m_p2pPrefix;
+};
+
+} // namespace ns3
+
+#endif // ADDRESS_PLAN_H
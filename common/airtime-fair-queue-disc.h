@@ -0,0 +1,201 @@
+#ifndef AIRTIME_FAIR_QUEUE_DISC_H
+#define AIRTIME_FAIR_QUEUE_DISC_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Fila da interface Wi-Fi do AP com justiça de tempo de meio entre os clientes: uma fila filha
+// (CoDel, por padrão) por endereço MAC de destino e um deficit round robin em que o crédito de cada
+// cliente é tempo de meio, e não bytes. Cada pacote custa FrameOverhead + bytes / DataRate, o mesmo
+// modelo de quadro do SharedMediumChannel. Assim um cliente com muito tráfego não atrasa os
+// pacotes (ACKs do TCP, por exemplo) dos outros, e cada cliente ativo recebe a mesma fração do
+// tempo de transmissão do AP, qualquer que seja o tamanho dos seus pacotes. Só escalona o que o
+// AP transmite; o tempo de meio que os próprios clientes usam no sentido de subida não passa por
+// aqui. As filas dos clientes são criadas no primeiro pacote para cada um.
+class AirtimeFairQueueDisc : public QueueDisc
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid =
+        TypeId("ns3::AirtimeFairQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<AirtimeFairQueueDisc>()
+            .AddAttribute("MaxSize", "Pacotes em todas as filas dos clientes",
+                          QueueSizeValue(QueueSize("10240p")),
+                          MakeQueueSizeAccessor(&QueueDisc::SetMaxSize, &QueueDisc::GetMaxSize),
+                          MakeQueueSizeChecker())
+            .AddAttribute("DataRate", "Taxa usada para estimar o tempo de meio de cada pacote",
+                          DataRateValue(DataRate("65Mbps")),
+                          MakeDataRateAccessor(&AirtimeFairQueueDisc::m_rate), MakeDataRateChecker())
+            .AddAttribute("FrameOverhead", "Tempo fixo por quadro (AIFS, preâmbulo, SIFS e ACK)",
+                          TimeValue(MicroSeconds(140)),
+                          MakeTimeAccessor(&AirtimeFairQueueDisc::m_overhead), MakeTimeChecker())
+            .AddAttribute("Quantum", "Crédito de tempo de meio de um cliente por rodada",
+                          TimeValue(MicroSeconds(300)),
+                          MakeTimeAccessor(&AirtimeFairQueueDisc::m_quantum), MakeTimeChecker())
+            .AddAttribute("ChildQueueDisc", "Fila de cada cliente",
+                          StringValue("ns3::CoDelQueueDisc"),
+                          MakeStringAccessor(&AirtimeFairQueueDisc::m_childType), MakeStringChecker());
+    return tid;
+  }
+
+  AirtimeFairQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::MULTIPLE_QUEUES, QueueSizeUnit::PACKETS)
+  {
+  }
+
+  // Clientes vistos até agora, na ordem do primeiro pacote, com o tempo de meio estimado de cada um
+  uint32_t GetNStations() const
+  {
+    return m_stations.size();
+  }
+
+  Address GetStationAddress(uint32_t i) const
+  {
+    return m_stations[i].address;
+  }
+
+  Time GetStationAirtime(uint32_t i) const
+  {
+    return m_stations[i].airtime;
+  }
+
+  static constexpr const char *LIMIT_EXCEEDED_DROP = "Queue disc limit exceeded";
+
+private:
+  struct Station
+  {
+    Address address;
+    Ptr<QueueDisc> queue;
+    Time deficit;
+    Time airtime;
+    bool active = false;
+  };
+
+  Time Airtime(uint32_t bytes) const
+  {
+    return m_overhead + m_rate.CalculateBytesTxTime(bytes);
+  }
+
+  bool DoEnqueue(Ptr<QueueDiscItem> item) override
+  {
+    if (GetCurrentSize() + item > GetMaxSize()) {
+      DropBeforeEnqueue(item, LIMIT_EXCEEDED_DROP);
+      return false;
+    }
+    uint32_t i = StationIndex(item->GetAddress());
+    Station &station = m_stations[i];
+    if (!station.queue->Enqueue(item)) {
+      return false;
+    }
+    if (!station.active) {
+      station.active = true;
+      station.deficit = m_quantum;
+      m_active.push_back(i);
+    }
+    return true;
+  }
+
+  // Deficit round robin: o cliente da frente transmite enquanto tiver crédito; sem crédito,
+  // recebe mais um quantum e vai para o fim da fila de clientes ativos
+  Ptr<QueueDiscItem> DoDequeue() override
+  {
+    while (!m_active.empty()) {
+      Station &station = m_stations[m_active.front()];
+      if (!station.deficit.IsStrictlyPositive()) {
+        station.deficit += m_quantum;
+        m_active.push_back(m_active.front());
+        m_active.pop_front();
+        continue;
+      }
+      Ptr<QueueDiscItem> item = station.queue->Dequeue();
+      if (!item) {
+        station.active = false;
+        m_active.pop_front();
+        continue;
+      }
+      Time airtime = Airtime(item->GetSize());
+      station.deficit -= airtime;
+      station.airtime += airtime;
+      return item;
+    }
+    return nullptr;
+  }
+
+  bool CheckConfig() override
+  {
+    NS_ABORT_MSG_IF(GetNQueueDiscClasses() > 0, "AirtimeFairQueueDisc cria as próprias classes");
+    NS_ABORT_MSG_IF(GetNPacketFilters() > 0 || GetNInternalQueues() > 0,
+                    "AirtimeFairQueueDisc não usa filtros nem filas internas");
+    return true;
+  }
+
+  void InitializeParams() override
+  {
+    m_childFactory.SetTypeId(m_childType);
+  }
+
+  uint32_t StationIndex(const Address &address)
+  {
+    auto it = m_index.find(address);
+    if (it != m_index.end()) {
+      return it->second;
+    }
+    Ptr<QueueDisc> queue = m_childFactory.Create<QueueDisc>();
+    queue->Initialize();
+    Ptr<QueueDiscClass> queueClass = CreateObject<QueueDiscClass>();
+    queueClass->SetQueueDisc(queue);
+    AddQueueDiscClass(queueClass);
+
+    uint32_t i = m_stations.size();
+    m_stations.push_back(Station());
+    m_stations.back().address = address;
+    m_stations.back().queue = queue;
+    m_index[address] = i;
+    return i;
+  }
+
+  DataRate m_rate;
+  Time m_overhead;
+  Time m_quantum;
+  std::string m_childType;
+  ObjectFactory m_childFactory;
+  std::vector<Station> m_stations;
+  std::map<Address, uint32_t> m_index;
+  std::deque<uint32_t> m_active; // clientes com pacotes, na ordem do rodízio
+};
+
+// TypeId da fila pelo nome curto usado na linha de comando; outros nomes passam direto
+inline std::string QueueDiscTypeName(const std::string &name)
+{
+  if (name == "fifo") {
+    return "ns3::FifoQueueDisc";
+  }
+  if (name == "codel") {
+    return "ns3::CoDelQueueDisc";
+  }
+  if (name == "fq_codel") {
+    return "ns3::FqCoDelQueueDisc";
+  }
+  if (name == "pie") {
+    return "ns3::PieQueueDisc";
+  }
+  if (name == "airtime") {
+    return AirtimeFairQueueDisc::GetTypeId().GetName();
+  }
+  return name;
+}
+
+} // namespace ns3
+
+#endif // AIRTIME_FAIR_QUEUE_DISC_H
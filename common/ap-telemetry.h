@@ -0,0 +1,366 @@
+#ifndef AP_TELEMETRY_H
+#define AP_TELEMETRY_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include "shared-medium-channel.h"
+
+#include <deque>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Buffer circular de tamanho fixo com as últimas amostras de uma série
+template <class T>
+class SampleRing
+{
+public:
+  explicit SampleRing(size_t capacity)
+    : m_buffer(capacity),
+      m_head(0),
+      m_size(0)
+  {
+  }
+
+  // Guarda a amostra; com o buffer cheio, a mais antiga sai em "evicted" e o retorno é true
+  bool Push(const T &sample, T &evicted)
+  {
+    bool full = m_size == m_buffer.size();
+    size_t slot = (m_head + m_size) % m_buffer.size();
+    if (full) {
+      evicted = m_buffer[m_head];
+      m_head = (m_head + 1) % m_buffer.size();
+    } else {
+      m_size++;
+    }
+    m_buffer[slot] = sample;
+    return full;
+  }
+
+  size_t GetSize() const
+  {
+    return m_size;
+  }
+
+  // i = 0: a amostra mais antiga ainda guardada
+  const T &Get(size_t i) const
+  {
+    return m_buffer[(m_head + i) % m_buffer.size()];
+  }
+
+private:
+  std::vector<T> m_buffer;
+  size_t m_head;
+  size_t m_size;
+};
+
+// Amostra do AP de uma célula. Filas: ocupação no instante da amostra; quedas e tempo de meio:
+// incremento desde a amostra anterior
+struct ApSample
+{
+  Time time;
+  uint32_t cell = 0;
+  uint32_t macPackets[4] = {}; // fila do MAC por AC (BE, BK, VI, VO); sem QoS ou meio compartilhado: só BE
+  uint32_t macBytes[4] = {};
+  uint64_t macDrops = 0;       // MPDUs descartados pelo MAC do AP (fila cheia, tentativas, validade)
+  uint32_t p2pPackets = 0;     // fila do dispositivo P2P do AP (sentido servidor)
+  uint32_t p2pBytes = 0;
+  uint32_t apQdiscPackets = 0; // filas do controle de tráfego (queue disc) acima do MAC e do P2P
+  uint32_t p2pQdiscPackets = 0;
+  uint64_t p2pDrops = 0;
+  double airtime = 0.0;        // fração do intervalo com o AP transmitindo
+};
+
+// Amostra de um cliente: fração do intervalo transmitindo, MPDUs descartados pelo MAC dele e a
+// fila do MAC do AP destinada a ele (todas as ACs; no meio compartilhado, 0)
+struct StaSample
+{
+  Time time;
+  uint32_t cell = 0;
+  uint32_t sta = 0;
+  double airtime = 0.0;
+  uint64_t drops = 0;
+  uint32_t apQueuePackets = 0;
+  uint32_t apQueueBytes = 0;
+};
+
+// Telemetria dos APs: a cada intervalo lê a ocupação das filas do MAC Wi-Fi (por AC) e do enlace
+// P2P do AP, as quedas e o tempo de meio do AP e de cada cliente. As filas são lidas só na
+// amostra; tempo de meio e quedas vêm de traces (mudança de estado do PHY e MPDU descartado),
+// que somam num contador sem alocar. No meio compartilhado (SharedMediumChannel) tudo é lido do
+// canal. As amostras ficam em dois SampleRing (AP e clientes) com as últimas "window" amostras de
+// cada um; a que sai do buffer é gravada no CSV correspondente, e Finish() grava o resto, então a
+// memória é fixa e os arquivos têm a série completa.
+class ApTelemetry
+{
+public:
+  ApTelemetry(Time interval, uint32_t window, const std::string &apFile, const std::string &staFile)
+    : m_interval(interval),
+      m_lastSample(Simulator::Now()),
+      m_apRing(window),
+      m_staRing(window),
+      m_finished(false)
+  {
+    m_apOut.open(apFile);
+    NS_ABORT_MSG_UNLESS(m_apOut, "Não foi possível criar " << apFile);
+    m_apOut << "timeS,cell,beQueuePackets,beQueueBytes,bkQueuePackets,bkQueueBytes,viQueuePackets,viQueueBytes,"
+            << "voQueuePackets,voQueueBytes,macDrops,p2pQueuePackets,p2pQueueBytes,p2pDrops,apQdiscPackets,p2pQdiscPackets,"
+            << "apAirtime\n";
+    m_staOut.open(staFile);
+    NS_ABORT_MSG_UNLESS(m_staOut, "Não foi possível criar " << staFile);
+    m_staOut << "timeS,cell,sta,airtime,macDrops,apQueuePackets,apQueueBytes\n";
+    m_event = Simulator::Schedule(m_interval, &ApTelemetry::Sample, this);
+  }
+
+  // Acompanha o AP de uma célula: dispositivo Wi-Fi (ou do meio compartilhado, com "medium"),
+  // dispositivos dos clientes e dispositivo P2P do AP
+  void AddCell(uint32_t cell, Ptr<NetDevice> apDevice, const NetDeviceContainer &staDevices,
+               Ptr<NetDevice> apP2pDevice, Ptr<SharedMediumChannel> medium)
+  {
+    m_cells.push_back(CellState());
+    CellState &state = m_cells.back();
+    state.cell = cell;
+    state.ap.device = apDevice;
+    state.p2p = DynamicCast<PointToPointNetDevice>(apP2pDevice);
+    if (Ptr<TrafficControlLayer> tc = apDevice->GetNode()->GetObject<TrafficControlLayer>()) {
+      state.apQdisc = tc->GetRootQueueDiscOnDevice(apDevice);
+      state.p2pQdisc = tc->GetRootQueueDiscOnDevice(apP2pDevice);
+    }
+    state.medium = medium;
+    state.stas.resize(staDevices.GetN());
+    for (uint32_t i = 0; i < staDevices.GetN(); i++) {
+      state.stas[i].device = staDevices.Get(i);
+    }
+    if (medium) {
+      return;
+    }
+    // Os traces recebem ponteiros para os contadores: m_cells é um deque (push_back não move as
+    // células existentes) e "stas" não muda de tamanho depois daqui
+    Connect(state.ap);
+    for (Station &sta : state.stas) {
+      Connect(sta);
+    }
+  }
+
+  // Grava a última amostra (parcial) e o que resta nos buffers e fecha os arquivos
+  void Finish()
+  {
+    if (m_finished) {
+      return;
+    }
+    m_finished = true;
+    m_event.Cancel();
+    Sample();
+    for (size_t i = 0; i < m_apRing.GetSize(); i++) {
+      Write(m_apRing.Get(i));
+    }
+    for (size_t i = 0; i < m_staRing.GetSize(); i++) {
+      Write(m_staRing.Get(i));
+    }
+    m_apOut.close();
+    m_staOut.close();
+  }
+
+  // Últimas amostras (no máximo "window" de cada série)
+  const SampleRing<ApSample> &GetApSamples() const
+  {
+    return m_apRing;
+  }
+
+  const SampleRing<StaSample> &GetStaSamples() const
+  {
+    return m_staRing;
+  }
+
+private:
+  // Contadores de um dispositivo Wi-Fi, acumulados pelos traces, e os valores da amostra anterior
+  struct Station
+  {
+    Ptr<NetDevice> device;
+    Time airtime;
+    uint64_t drops = 0;
+    Time lastAirtime;
+    uint64_t lastDrops = 0;
+  };
+
+  struct CellState
+  {
+    uint32_t cell = 0;
+    Station ap;
+    std::vector<Station> stas;
+    Ptr<PointToPointNetDevice> p2p;
+    Ptr<SharedMediumChannel> medium;
+    Ptr<QueueDisc> apQdisc;
+    Ptr<QueueDisc> p2pQdisc;
+    uint64_t lastP2pDrops = 0;
+  };
+
+  static void PhyState(Time *airtime, Time start, Time duration, WifiPhyState state)
+  {
+    if (state == WifiPhyState::TX) {
+      *airtime += duration;
+    }
+  }
+
+  static void MacDrop(uint64_t *drops, WifiMacDropReason reason, Ptr<const WifiMpdu> mpdu)
+  {
+    (*drops)++;
+  }
+
+  static void Connect(Station &station)
+  {
+    Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(station.device);
+    if (!wifi) {
+      return;
+    }
+    wifi->GetPhy()->GetState()->TraceConnectWithoutContext("State",
+                                                          MakeBoundCallback(&ApTelemetry::PhyState, &station.airtime));
+    wifi->GetMac()->TraceConnectWithoutContext("DroppedMpdu", MakeBoundCallback(&ApTelemetry::MacDrop, &station.drops));
+  }
+
+  // Fila do MAC do AP para o cliente "sta": as filas por destinatário do WifiMacQueue (uma por TID
+  // com QoS, na fila da AC do TID; uma só sem QoS)
+  static void ReceiverQueue(Ptr<WifiMac> apMac, Ptr<NetDevice> sta, uint32_t &packets, uint32_t &bytes)
+  {
+    Mac48Address address = Mac48Address::ConvertFrom(sta->GetAddress());
+    packets = 0;
+    bytes = 0;
+    if (!apMac->GetQosSupported()) {
+      WifiContainerQueueId id(WIFI_DATA_QUEUE, address, std::nullopt);
+      Ptr<WifiMacQueue> queue = apMac->GetTxopQueue(AC_BE_NQOS);
+      packets = queue->GetNPackets(id);
+      bytes = queue->GetNBytes(id);
+      return;
+    }
+    for (uint8_t tid = 0; tid < 8; tid++) {
+      WifiContainerQueueId id(WIFI_QOSDATA_UNICAST_QUEUE, address, tid);
+      Ptr<WifiMacQueue> queue = apMac->GetTxopQueue(QosUtilsMapTidToAc(tid));
+      packets += queue->GetNPackets(id);
+      bytes += queue->GetNBytes(id);
+    }
+  }
+
+  // Tempo de meio e quedas acumulados; no meio compartilhado, lidos do canal
+  static void Totals(const CellState &state, const Station &station, Time &airtime, uint64_t &drops)
+  {
+    if (state.medium) {
+      airtime = state.medium->GetAirtime(station.device);
+      drops = state.medium->GetDrops(station.device);
+    } else {
+      airtime = station.airtime;
+      drops = station.drops;
+    }
+  }
+
+  void Sample()
+  {
+    Time now = Simulator::Now();
+    double elapsed = (now - m_lastSample).GetSeconds();
+    m_lastSample = now;
+
+    for (CellState &state : m_cells) {
+      ApSample ap;
+      ap.time = now;
+      ap.cell = state.cell;
+      Ptr<WifiMac> mac;
+      if (state.medium) {
+        ap.macPackets[0] = state.medium->GetQueueLength(state.ap.device);
+      } else if (Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(state.ap.device)) {
+        mac = wifi->GetMac();
+        if (!mac->GetQosSupported()) {
+          // Sem QoS o MAC tem uma única fila (DCF), contada como BE
+          Ptr<WifiMacQueue> queue = mac->GetTxopQueue(AC_BE_NQOS);
+          ap.macPackets[0] = queue->GetNPackets();
+          ap.macBytes[0] = queue->GetNBytes();
+        } else {
+          const AcIndex acs[4] = {AC_BE, AC_BK, AC_VI, AC_VO};
+          for (uint32_t i = 0; i < 4; i++) {
+            Ptr<WifiMacQueue> queue = mac->GetTxopQueue(acs[i]);
+            ap.macPackets[i] = queue->GetNPackets();
+            ap.macBytes[i] = queue->GetNBytes();
+          }
+        }
+      }
+      Time airtime;
+      uint64_t drops;
+      Totals(state, state.ap, airtime, drops);
+      ap.macDrops = drops - state.ap.lastDrops;
+      ap.airtime = elapsed > 0 ? (airtime - state.ap.lastAirtime).GetSeconds() / elapsed : 0.0;
+      state.ap.lastAirtime = airtime;
+      state.ap.lastDrops = drops;
+      if (state.p2p) {
+        Ptr<Queue<Packet>> queue = state.p2p->GetQueue();
+        ap.p2pPackets = queue->GetNPackets();
+        ap.p2pBytes = queue->GetNBytes();
+        ap.p2pDrops = queue->GetTotalDroppedPackets() - state.lastP2pDrops;
+        state.lastP2pDrops = queue->GetTotalDroppedPackets();
+      }
+      ap.apQdiscPackets = state.apQdisc ? state.apQdisc->GetNPackets() : 0;
+      ap.p2pQdiscPackets = state.p2pQdisc ? state.p2pQdisc->GetNPackets() : 0;
+      ApSample evictedAp;
+      if (m_apRing.Push(ap, evictedAp)) {
+        Write(evictedAp);
+      }
+
+      for (uint32_t i = 0; i < state.stas.size(); i++) {
+        Station &station = state.stas[i];
+        Totals(state, station, airtime, drops);
+        StaSample sta;
+        sta.time = now;
+        sta.cell = state.cell;
+        sta.sta = i;
+        sta.airtime = elapsed > 0 ? (airtime - station.lastAirtime).GetSeconds() / elapsed : 0.0;
+        sta.drops = drops - station.lastDrops;
+        if (mac) {
+          ReceiverQueue(mac, station.device, sta.apQueuePackets, sta.apQueueBytes);
+        }
+        station.lastAirtime = airtime;
+        station.lastDrops = drops;
+        StaSample evictedSta;
+        if (m_staRing.Push(sta, evictedSta)) {
+          Write(evictedSta);
+        }
+      }
+    }
+    if (!m_finished) {
+      m_event = Simulator::Schedule(m_interval, &ApTelemetry::Sample, this);
+    }
+  }
+
+  void Write(const ApSample &s)
+  {
+    m_apOut << s.time.GetSeconds() << "," << s.cell;
+    for (uint32_t i = 0; i < 4; i++) {
+      m_apOut << "," << s.macPackets[i] << "," << s.macBytes[i];
+    }
+    m_apOut << "," << s.macDrops << "," << s.p2pPackets << "," << s.p2pBytes << "," << s.p2pDrops << ","
+            << s.apQdiscPackets << "," << s.p2pQdiscPackets << "," << s.airtime << "\n";
+  }
+
+  void Write(const StaSample &s)
+  {
+    m_staOut << s.time.GetSeconds() << "," << s.cell << "," << s.sta << "," << s.airtime << "," << s.drops << ","
+             << s.apQueuePackets << "," << s.apQueueBytes << "\n";
+  }
+
+  Time m_interval;
+  Time m_lastSample;
+  std::deque<CellState> m_cells;
+  SampleRing<ApSample> m_apRing;
+  SampleRing<StaSample> m_staRing;
+  std::ofstream m_apOut;
+  std::ofstream m_staOut;
+  bool m_finished;
+  EventId m_event;
+};
+
+} // namespace ns3
+
+#endif // AP_TELEMETRY_H
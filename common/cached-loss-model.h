@@ -0,0 +1,160 @@
+#ifndef CACHED_LOSS_MODEL_H
+#define CACHED_LOSS_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+// Guarda o ganho (potência recebida - potência transmitida, em dB) calculado pelo modelo "Inner"
+// para cada par (transmissor, receptor). O valor só é reaproveitado enquanto os dois nós estão
+// parados; quando um MobilityModel avisa mudança de curso, a linha e a coluna dele são
+// descartadas e o estado (parado ou não) é relido. Nós em movimento sempre passam pelo modelo
+// interno. Só serve para modelos determinísticos cujo ganho não depende da potência (ex.:
+// log-distância); com eles o resultado é idêntico ao do modelo interno.
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CachedPropagationLossModel")
+                            .SetParent<PropagationLossModel>()
+                            .SetGroupName("Propagation")
+                            .AddConstructor<CachedPropagationLossModel>()
+                            .AddAttribute("Inner", "Modelo de perda cujo resultado é guardado",
+                                          PointerValue(),
+                                          MakePointerAccessor(&CachedPropagationLossModel::m_inner),
+                                          MakePointerChecker<PropagationLossModel>());
+    return tid;
+  }
+
+  CachedPropagationLossModel()
+    : m_stride(0),
+      m_hits(0),
+      m_misses(0)
+  {
+  }
+
+  void SetInner(Ptr<PropagationLossModel> inner)
+  {
+    m_inner = inner;
+  }
+
+  uint64_t GetHits() const
+  {
+    return m_hits;
+  }
+
+  uint64_t GetMisses() const
+  {
+    return m_misses;
+  }
+
+private:
+  struct Model
+  {
+    uint32_t index;
+    bool stationary;
+  };
+
+  double DoCalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override
+  {
+    const Model &ma = Lookup(a);
+    const Model &mb = Lookup(b);
+    if (!ma.stationary || !mb.stationary) {
+      m_misses++;
+      return m_inner->CalcRxPower(txPowerDbm, a, b);
+    }
+
+    double &gain = m_gain[static_cast<size_t>(ma.index) * m_stride + mb.index];
+    if (std::isnan(gain)) {
+      m_misses++;
+      gain = m_inner->CalcRxPower(0.0, a, b);
+    } else {
+      m_hits++;
+    }
+    return txPowerDbm + gain;
+  }
+
+  int64_t DoAssignStreams(int64_t stream) override
+  {
+    return m_inner->AssignStreams(stream);
+  }
+
+  // Estado do modelo de mobilidade; na primeira vez ele ganha um índice na matriz de ganhos
+  const Model &Lookup(Ptr<MobilityModel> mobility) const
+  {
+    auto it = m_models.find(PeekPointer(mobility));
+    if (it != m_models.end()) {
+      return it->second;
+    }
+
+    uint32_t index = m_models.size();
+    if (index >= m_stride) {
+      Grow(std::max<uint32_t>(16, 2 * m_stride));
+    }
+    mobility->TraceConnectWithoutContext("CourseChange",
+                                         MakeCallback(&CachedPropagationLossModel::CourseChanged,
+                                                      const_cast<CachedPropagationLossModel *>(this)));
+    Model &model = m_models[PeekPointer(mobility)];
+    model.index = index;
+    model.stationary = IsStationary(mobility);
+    return model;
+  }
+
+  void CourseChanged(Ptr<const MobilityModel> mobility)
+  {
+    auto it = m_models.find(PeekPointer(mobility));
+    if (it == m_models.end()) {
+      return;
+    }
+    it->second.stationary = IsStationary(mobility);
+    uint32_t i = it->second.index;
+    for (uint32_t j = 0; j < m_stride; j++) {
+      m_gain[static_cast<size_t>(i) * m_stride + j] = Unknown();
+      m_gain[static_cast<size_t>(j) * m_stride + i] = Unknown();
+    }
+  }
+
+  static bool IsStationary(Ptr<const MobilityModel> mobility)
+  {
+    Vector v = mobility->GetVelocity();
+    return v.x == 0 && v.y == 0 && v.z == 0;
+  }
+
+  static double Unknown()
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  // Aumenta a matriz de ganhos mantendo os valores já calculados
+  void Grow(uint32_t stride) const
+  {
+    std::vector<double> gain(static_cast<size_t>(stride) * stride, Unknown());
+    for (uint32_t i = 0; i < m_stride; i++) {
+      for (uint32_t j = 0; j < m_stride; j++) {
+        gain[static_cast<size_t>(i) * stride + j] = m_gain[static_cast<size_t>(i) * m_stride + j];
+      }
+    }
+    m_gain.swap(gain);
+    m_stride = stride;
+  }
+
+  Ptr<PropagationLossModel> m_inner;
+  mutable std::unordered_map<const MobilityModel *, Model> m_models;
+  mutable std::vector<double> m_gain; // m_stride x m_stride, NaN = não calculado
+  mutable uint32_t m_stride;
+  mutable uint64_t m_hits;
+  mutable uint64_t m_misses;
+};
+
+} // namespace ns3
+
+#endif // CACHED_LOSS_MODEL_H
@@ -0,0 +1,397 @@
+#ifndef COMPACT_FLOW_MONITOR_H
+#define COMPACT_FLOW_MONITOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include "flow-recorder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Quantil p estimado sem guardar as amostras (algoritmo P² de Jain e Chlamtac): cinco marcadores
+// cujas alturas são ajustadas por interpolação parabólica a cada nova amostra
+class P2Quantile
+{
+public:
+  explicit P2Quantile(double p = 0.5)
+    : m_p(p),
+      m_count(0)
+  {
+  }
+
+  void Add(double x)
+  {
+    if (m_count < 5) {
+      m_q[m_count++] = x;
+      if (m_count == 5) {
+        std::sort(m_q, m_q + 5);
+        for (int i = 0; i < 5; i++) {
+          m_n[i] = i;
+        }
+        m_desired[0] = 0;
+        m_desired[1] = 2 * m_p;
+        m_desired[2] = 4 * m_p;
+        m_desired[3] = 2 + 2 * m_p;
+        m_desired[4] = 4;
+      }
+      return;
+    }
+
+    int k;
+    if (x < m_q[0]) {
+      m_q[0] = x;
+      k = 0;
+    } else if (x >= m_q[4]) {
+      m_q[4] = x;
+      k = 3;
+    } else {
+      k = 0;
+      while (x >= m_q[k + 1]) {
+        k++;
+      }
+    }
+    for (int i = k + 1; i < 5; i++) {
+      m_n[i]++;
+    }
+    const double increment[5] = {0, m_p / 2, m_p, (1 + m_p) / 2, 1};
+    for (int i = 0; i < 5; i++) {
+      m_desired[i] += increment[i];
+    }
+    m_count++;
+
+    for (int i = 1; i < 4; i++) {
+      double d = m_desired[i] - m_n[i];
+      if ((d >= 1 && m_n[i + 1] - m_n[i] > 1) || (d <= -1 && m_n[i - 1] - m_n[i] < -1)) {
+        int s = d >= 0 ? 1 : -1;
+        double q = Parabolic(i, s);
+        m_q[i] = (m_q[i - 1] < q && q < m_q[i + 1]) ? q : m_q[i] + s * (m_q[i + s] - m_q[i]) / (m_n[i + s] - m_n[i]);
+        m_n[i] += s;
+      }
+    }
+  }
+
+  double Get() const
+  {
+    if (m_count == 0) {
+      return 0.0;
+    }
+    if (m_count < 5) {
+      double sorted[5];
+      std::copy(m_q, m_q + m_count, sorted);
+      std::sort(sorted, sorted + m_count);
+      return sorted[static_cast<uint32_t>(m_p * (m_count - 1) + 0.5)];
+    }
+    return m_q[2];
+  }
+
+private:
+  double Parabolic(int i, int s) const
+  {
+    return m_q[i] + s / (m_n[i + 1] - m_n[i - 1]) *
+                        ((m_n[i] - m_n[i - 1] + s) * (m_q[i + 1] - m_q[i]) / (m_n[i + 1] - m_n[i]) +
+                         (m_n[i + 1] - m_n[i] - s) * (m_q[i] - m_q[i - 1]) / (m_n[i] - m_n[i - 1]));
+  }
+
+  double m_p;
+  uint32_t m_count;
+  double m_q[5];       // alturas dos marcadores
+  double m_n[5];       // posições dos marcadores
+  double m_desired[5]; // posições desejadas
+};
+
+// Identificador do fluxo e instante de envio, levados pelo pacote da origem ao destino
+class CompactFlowTag : public Tag
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::CompactFlowTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("FlowMonitor")
+                            .AddConstructor<CompactFlowTag>();
+    return tid;
+  }
+
+  CompactFlowTag()
+    : m_flowId(0),
+      m_txTime(0)
+  {
+  }
+
+  CompactFlowTag(FlowId flowId, Time txTime)
+    : m_flowId(flowId),
+      m_txTime(txTime.GetTimeStep())
+  {
+  }
+
+  TypeId GetInstanceTypeId() const override
+  {
+    return GetTypeId();
+  }
+
+  uint32_t GetSerializedSize() const override
+  {
+    return 12;
+  }
+
+  void Serialize(TagBuffer i) const override
+  {
+    i.WriteU32(m_flowId);
+    i.WriteU64(m_txTime);
+  }
+
+  void Deserialize(TagBuffer i) override
+  {
+    m_flowId = i.ReadU32();
+    m_txTime = i.ReadU64();
+  }
+
+  void Print(std::ostream &os) const override
+  {
+    os << "flowId=" << m_flowId << " txTime=" << GetTxTime();
+  }
+
+  FlowId GetFlowId() const
+  {
+    return m_flowId;
+  }
+
+  Time GetTxTime() const
+  {
+    return TimeStep(m_txTime);
+  }
+
+private:
+  uint32_t m_flowId;
+  int64_t m_txTime;
+};
+
+// Monitor de fluxos enxuto: escuta só o IPv4 dos nós de origem e destino (SendOutgoing e
+// LocalDeliver), sem sondas nos nós intermediários. O pacote leva numa tag o fluxo e o instante
+// de envio, então não há mapa de pacotes em trânsito; as estatísticas ficam em vetores indexados
+// pelo FlowId (registros de tamanho fixo) e os histogramas dão lugar a estimadores P² dos quantis
+// 50, 95 e 99 do atraso. A classificação e os FlowIds são os do Ipv4FlowClassifier.
+//
+// Perdas: os envios de cada fluxo são contados em épocas de maxDelay/8; quando todos os pacotes
+// de uma época passam de maxDelay sem recepção, os que faltam viram lostPackets (inclui os
+// descartados no caminho, como o FlowMonitor, que também conta os descartes como perdas). Um
+// pacote que chega depois do fechamento da sua época fica só como perda, sem contar como recebido.
+class CompactFlowMonitor : public FlowRecorder
+{
+public:
+  explicit CompactFlowMonitor(Time maxDelay = Seconds(10.0))
+    : m_classifier(Create<Ipv4FlowClassifier>()),
+      m_maxDelay(maxDelay),
+      m_epoch(maxDelay / EPOCHS_PER_DELAY)
+  {
+  }
+
+  // Escuta o IPv4 dos nós (só as pontas dos fluxos: clientes e servidores)
+  void Install(const NodeContainer &nodes)
+  {
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      Ptr<Ipv4L3Protocol> ipv4 = nodes.Get(i)->GetObject<Ipv4L3Protocol>();
+      if (ipv4) {
+        ipv4->TraceConnectWithoutContext("SendOutgoing", MakeCallback(&CompactFlowMonitor::SendOutgoing, this));
+        ipv4->TraceConnectWithoutContext("LocalDeliver", MakeCallback(&CompactFlowMonitor::LocalDeliver, this));
+      }
+    }
+  }
+
+  void CheckForLostPackets() override
+  {
+    int64_t now = Simulator::Now().GetTimeStep();
+    for (size_t f = 0; f < m_epochs.size(); f++) {
+      for (uint32_t slot = 0; slot < EPOCH_SLOTS; slot++) {
+        int64_t id = m_epochs[f].id[slot];
+        if (id >= 0 && (id + 1) * m_epoch.GetTimeStep() + m_maxDelay.GetTimeStep() <= now) {
+          CloseEpoch(f, slot);
+        }
+      }
+    }
+  }
+
+  void FlushLostPackets() override
+  {
+    for (size_t f = 0; f < m_epochs.size(); f++) {
+      for (uint32_t slot = 0; slot < EPOCH_SLOTS; slot++) {
+        CloseEpoch(f, slot);
+      }
+    }
+  }
+
+  const std::vector<FlowRecord> &GetFlowRecords() override
+  {
+    for (size_t f = 0; f < m_records.size(); f++) {
+      m_records[f].delayP50 = m_sketches[f].p50.Get();
+      m_records[f].delayP95 = m_sketches[f].p95.Get();
+      m_records[f].delayP99 = m_sketches[f].p99.Get();
+    }
+    return m_records;
+  }
+
+  Ptr<Ipv4FlowClassifier> GetClassifier() const override
+  {
+    return m_classifier;
+  }
+
+  // Mesmo formato do XML do FlowMonitor, sem histogramas nem sondas e com os quantis do atraso
+  void SerializeToXmlFile(const std::string &fileName, bool histograms, bool probes) override
+  {
+    CheckForLostPackets();
+    std::ofstream os(fileName);
+    os << "<?xml version=\"1.0\" ?>\n<FlowMonitor>\n  <FlowStats>\n";
+    for (const FlowRecord &r : GetFlowRecords()) {
+      os << "    <Flow flowId=\"" << r.flowId << "\" timeFirstTxPacket=\"" << r.timeFirstTxPacket
+         << "\" timeFirstRxPacket=\"" << r.timeFirstRxPacket << "\" timeLastTxPacket=\"" << r.timeLastTxPacket
+         << "\" timeLastRxPacket=\"" << r.timeLastRxPacket << "\" delaySum=\"" << r.delaySum << "\" jitterSum=\""
+         << r.jitterSum << "\" lastDelay=\"" << r.lastDelay << "\" txBytes=\"" << r.txBytes << "\" rxBytes=\""
+         << r.rxBytes << "\" txPackets=\"" << r.txPackets << "\" rxPackets=\"" << r.rxPackets
+         << "\" lostPackets=\"" << r.lostPackets << "\" delayP50=\"" << r.delayP50 << "\" delayP95=\""
+         << r.delayP95 << "\" delayP99=\"" << r.delayP99 << "\" />\n";
+    }
+    os << "  </FlowStats>\n";
+    m_classifier->SerializeToXmlStream(os, 2);
+    os << "</FlowMonitor>\n";
+  }
+
+private:
+  static const uint32_t EPOCHS_PER_DELAY = 8;
+  // Épocas que podem estar abertas ao mesmo tempo (maxDelay mais a época corrente e a anterior)
+  static const uint32_t EPOCH_SLOTS = EPOCHS_PER_DELAY + 2;
+
+  struct DelaySketch
+  {
+    P2Quantile p50{0.50};
+    P2Quantile p95{0.95};
+    P2Quantile p99{0.99};
+  };
+
+  // Envios e recepções de cada época aberta; id = -1 marca posição livre
+  struct Epochs
+  {
+    int64_t id[EPOCH_SLOTS];
+    uint32_t tx[EPOCH_SLOTS];
+    uint32_t rx[EPOCH_SLOTS];
+  };
+
+  size_t FlowIndex(FlowId flowId)
+  {
+    size_t index = flowId - 1;
+    while (m_records.size() <= index) {
+      m_records.push_back(FlowRecord());
+      m_records.back().flowId = m_records.size();
+      m_sketches.push_back(DelaySketch());
+      Epochs epochs;
+      std::fill(epochs.id, epochs.id + EPOCH_SLOTS, -1);
+      std::fill(epochs.tx, epochs.tx + EPOCH_SLOTS, 0);
+      std::fill(epochs.rx, epochs.rx + EPOCH_SLOTS, 0);
+      m_epochs.push_back(epochs);
+    }
+    return index;
+  }
+
+  void CloseEpoch(size_t f, uint32_t slot)
+  {
+    Epochs &epochs = m_epochs[f];
+    if (epochs.id[slot] >= 0 && epochs.tx[slot] > epochs.rx[slot]) {
+      m_records[f].lostPackets += epochs.tx[slot] - epochs.rx[slot];
+    }
+    epochs.id[slot] = -1;
+    epochs.tx[slot] = 0;
+    epochs.rx[slot] = 0;
+  }
+
+  void SendOutgoing(const Ipv4Header &header, Ptr<const Packet> payload, uint32_t interface)
+  {
+    uint32_t flowId;
+    uint32_t packetId;
+    if (!m_classifier->Classify(header, payload, &flowId, &packetId)) {
+      return;
+    }
+    Time now = Simulator::Now();
+    size_t f = FlowIndex(flowId);
+    FlowRecord &record = m_records[f];
+    record.txBytes += payload->GetSize() + header.GetSerializedSize();
+    record.txPackets++;
+    if (record.txPackets == 1) {
+      record.timeFirstTxPacket = now;
+    }
+    record.timeLastTxPacket = now;
+
+    // A posição da época é reaproveitada só depois de todos os pacotes dela passarem de maxDelay
+    int64_t epoch = now.GetTimeStep() / m_epoch.GetTimeStep();
+    uint32_t slot = epoch % EPOCH_SLOTS;
+    if (m_epochs[f].id[slot] != epoch) {
+      CloseEpoch(f, slot);
+      m_epochs[f].id[slot] = epoch;
+    }
+    m_epochs[f].tx[slot]++;
+
+    payload->AddPacketTag(CompactFlowTag(flowId, now));
+  }
+
+  void LocalDeliver(const Ipv4Header &header, Ptr<const Packet> payload, uint32_t interface)
+  {
+    // Retira a tag, como o FlowMonitor, para que um pacote reenviado (eco) não a leve duas vezes
+    CompactFlowTag tag;
+    if (!ConstCast<Packet>(payload)->RemovePacketTag(tag) || tag.GetFlowId() == 0 ||
+        tag.GetFlowId() > m_records.size()) {
+      return;
+    }
+    size_t f = tag.GetFlowId() - 1;
+    // A época do envio já fechada: o pacote chegou depois de maxDelay e já foi contado como
+    // perdido, como o FlowMonitor, que também descarta as chegadas tardias
+    int64_t epoch = tag.GetTxTime().GetTimeStep() / m_epoch.GetTimeStep();
+    uint32_t slot = epoch % EPOCH_SLOTS;
+    if (m_epochs[f].id[slot] != epoch) {
+      return;
+    }
+    m_epochs[f].rx[slot]++;
+
+    Time now = Simulator::Now();
+    FlowRecord &record = m_records[f];
+    Time delay = now - tag.GetTxTime();
+    record.delaySum += delay;
+    if (record.rxPackets > 0) {
+      Time jitter = record.lastDelay - delay;
+      if (jitter.IsPositive()) {
+        record.jitterSum += jitter;
+      } else {
+        record.jitterSum -= jitter;
+      }
+    }
+    record.lastDelay = delay;
+    record.rxBytes += payload->GetSize() + header.GetSerializedSize();
+    record.rxPackets++;
+    if (record.rxPackets == 1) {
+      record.timeFirstRxPacket = now;
+    }
+    record.timeLastRxPacket = now;
+
+    DelaySketch &sketch = m_sketches[f];
+    sketch.p50.Add(delay.GetSeconds());
+    sketch.p95.Add(delay.GetSeconds());
+    sketch.p99.Add(delay.GetSeconds());
+  }
+
+  Ptr<Ipv4FlowClassifier> m_classifier;
+  Time m_maxDelay;
+  Time m_epoch;
+
+  // Vetores paralelos indexados por FlowId - 1
+  std::vector<FlowRecord> m_records;
+  std::vector<DelaySketch> m_sketches;
+  std::vector<Epochs> m_epochs;
+};
+
+} // namespace ns3
+
+#endif // COMPACT_FLOW_MONITOR_H
@@ -0,0 +1,264 @@
+#ifndef CONVERGENCE_MONITOR_H
+#define CONVERGENCE_MONITOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include "flow-recorder.h"
+#include "shared-medium-channel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+
+namespace ns3 {
+
+// Quantil 0,975 da t de Student (intervalo de confiança de 95%) com "df" graus de liberdade
+inline double StudentT975(uint32_t df)
+{
+  static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                 2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                 2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (df == 0) {
+    return INFINITY;
+  }
+  if (df <= 30) {
+    return table[df - 1];
+  }
+  // Expansão de Cornish-Fisher em torno da normal (erro < 0,003 a partir de 30 graus)
+  const double z = 1.959964;
+  return z + (z * z * z + z) / (4.0 * df);
+}
+
+// Critérios de parada antecipada de uma rodada:
+//  - convergência: a partir de appStart + warmup, as estatísticas por fluxo são lidas a cada "batch" e cada
+//    lote vira uma amostra da vazão e do atraso médio de cada fluxo (médias por lotes). Quando
+//    todos os fluxos ativos têm, nas duas métricas, meia-largura do IC de 95% menor que
+//    "target" vezes a média, depois de pelo menos minBatches lotes, a simulação para;
+//  - esvaziamento: depois de appStop, a simulação para assim que as filas dos dispositivos e das
+//    queue discs estão vazias e nenhum contador dos fluxos mudou durante "quiet" (que deve
+//    cobrir um RTO do TCP, 1 s no mínimo do ns-3, para não cortar uma retransmissão pendente).
+// Sem esses critérios a rodada termina em simStop, como antes.
+class ConvergenceMonitor
+{
+public:
+  ConvergenceMonitor(Ptr<FlowRecorder> recorder, const NodeContainer &nodes)
+    : m_recorder(recorder),
+      m_nodes(nodes),
+      m_target(0.0),
+      m_minBatches(0),
+      m_batches(0),
+      m_lastActivity(0),
+      m_converged(false),
+      m_drained(false)
+  {
+  }
+
+  ~ConvergenceMonitor()
+  {
+    m_batchEvent.Cancel();
+    m_drainEvent.Cancel();
+  }
+
+  // Liga o critério de convergência; o primeiro lote começa em "start"
+  void EnableConvergence(Time start, Time batch, double target, uint32_t minBatches)
+  {
+    m_batch = batch;
+    m_target = target;
+    m_minBatches = std::max<uint32_t>(minBatches, 2);
+    m_batchEvent = Simulator::Schedule(start, &ConvergenceMonitor::StartBatches, this);
+  }
+
+  // Liga o critério de esvaziamento a partir de "appStop"
+  void EnableDrain(Time appStop, Time quiet)
+  {
+    m_quiet = quiet;
+    m_drainEvent = Simulator::Schedule(appStop, &ConvergenceMonitor::CheckDrain, this);
+  }
+
+  bool HasConverged() const
+  {
+    return m_converged;
+  }
+
+  bool HasDrained() const
+  {
+    return m_drained;
+  }
+
+  uint32_t GetBatches() const
+  {
+    return m_batches;
+  }
+
+private:
+  // Médias e variâncias acumuladas pelo método de Welford
+  struct Estimate
+  {
+    uint32_t n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void Add(double x)
+    {
+      n++;
+      double delta = x - mean;
+      mean += delta / n;
+      m2 += delta * (x - mean);
+    }
+
+    // Meia-largura do IC de 95% relativa à média (infinito sem amostras suficientes)
+    double RelativeHalfWidth() const
+    {
+      if (n < 2 || mean <= 0) {
+        return INFINITY;
+      }
+      return StudentT975(n - 1) * std::sqrt(m2 / (n - 1) / n) / mean;
+    }
+  };
+
+  struct FlowBatches
+  {
+    uint64_t rxBytes = 0;
+    uint32_t rxPackets = 0;
+    Time delaySum;
+    Estimate throughput; // bit/s
+    Estimate delay;      // s
+  };
+
+  void StartBatches()
+  {
+    for (const FlowRecord &st : m_recorder->GetFlowRecords()) {
+      FlowBatches &flow = m_flows[st.flowId];
+      flow.rxBytes = st.rxBytes;
+      flow.rxPackets = st.rxPackets;
+      flow.delaySum = st.delaySum;
+    }
+    m_batchEvent = Simulator::Schedule(m_batch, &ConvergenceMonitor::EndBatch, this);
+  }
+
+  void EndBatch()
+  {
+    m_batches++;
+    double worst = 0.0;
+    for (const FlowRecord &st : m_recorder->GetFlowRecords()) {
+      FlowBatches &flow = m_flows[st.flowId];
+      flow.throughput.Add((st.rxBytes - flow.rxBytes) * 8.0 / m_batch.GetSeconds());
+      uint32_t packets = st.rxPackets - flow.rxPackets;
+      if (packets > 0) {
+        flow.delay.Add((st.delaySum - flow.delaySum).GetSeconds() / packets);
+      }
+      flow.rxBytes = st.rxBytes;
+      flow.rxPackets = st.rxPackets;
+      flow.delaySum = st.delaySum;
+
+      // Fluxos que nunca entregaram nada (ex.: só o ACK de um TCP já encerrado) não contam
+      if (flow.throughput.mean > 0) {
+        worst = std::max(worst, flow.throughput.RelativeHalfWidth());
+        worst = std::max(worst, flow.delay.RelativeHalfWidth());
+      }
+    }
+
+    if (m_batches >= m_minBatches && worst <= m_target) {
+      m_converged = true;
+      std::cout << "Convergência em " << Simulator::Now().GetSeconds() << " s: " << m_batches
+                << " lotes, maior meia-largura relativa do IC 95% = " << worst * 100 << "%" << std::endl;
+      Simulator::Stop();
+      return;
+    }
+    m_batchEvent = Simulator::Schedule(m_batch, &ConvergenceMonitor::EndBatch, this);
+  }
+
+  void CheckDrain()
+  {
+    uint64_t activity = 0;
+    for (const FlowRecord &st : m_recorder->GetFlowRecords()) {
+      activity += st.txPackets + st.rxPackets;
+    }
+    if (activity != m_lastActivity || !QueuesEmpty()) {
+      m_lastActivity = activity;
+      m_lastChange = Simulator::Now();
+    } else if (Simulator::Now() - m_lastChange >= m_quiet) {
+      m_drained = true;
+      std::cout << "Filas vazias e sem tráfego desde " << m_lastChange.GetSeconds() << " s; fim em "
+                << Simulator::Now().GetSeconds() << " s" << std::endl;
+      Simulator::Stop();
+      return;
+    }
+    // Dez verificações por período de silêncio
+    m_drainEvent = Simulator::Schedule(m_quiet / 10, &ConvergenceMonitor::CheckDrain, this);
+  }
+
+  bool QueuesEmpty() const
+  {
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
+      Ptr<Node> node = m_nodes.Get(i);
+      Ptr<TrafficControlLayer> tc = node->GetObject<TrafficControlLayer>();
+      for (uint32_t d = 0; d < node->GetNDevices(); d++) {
+        Ptr<NetDevice> device = node->GetDevice(d);
+        if (!DeviceIdle(device)) {
+          return false;
+        }
+        Ptr<QueueDisc> disc;
+        if (tc) {
+          disc = tc->GetRootQueueDiscOnDevice(device);
+        }
+        if (disc && disc->GetNPackets() > 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static bool DeviceIdle(Ptr<NetDevice> device)
+  {
+    if (Ptr<PointToPointNetDevice> p2p = DynamicCast<PointToPointNetDevice>(device)) {
+      return p2p->GetQueue()->IsEmpty();
+    }
+    if (Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(device)) {
+      Ptr<WifiMac> mac = wifi->GetMac();
+      if (!mac->GetQosSupported()) {
+        return mac->GetTxopQueue(AC_BE_NQOS)->IsEmpty();
+      }
+      for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
+        if (!mac->GetTxopQueue(ac)->IsEmpty()) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if (Ptr<SharedMediumChannel> medium = DynamicCast<SharedMediumChannel>(device->GetChannel())) {
+      return medium->IsIdle();
+    }
+    return true;
+  }
+
+  Ptr<FlowRecorder> m_recorder;
+  NodeContainer m_nodes;
+
+  Time m_batch;
+  double m_target;
+  uint32_t m_minBatches;
+  uint32_t m_batches;
+  std::map<FlowId, FlowBatches> m_flows;
+  EventId m_batchEvent;
+
+  Time m_quiet;
+  uint64_t m_lastActivity;
+  Time m_lastChange;
+  EventId m_drainEvent;
+
+  bool m_converged;
+  bool m_drained;
+};
+
+} // namespace ns3
+
+#endif // CONVERGENCE_MONITOR_H
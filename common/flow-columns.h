@@ -0,0 +1,273 @@
+#ifndef FLOW_COLUMNS_H
+#define FLOW_COLUMNS_H
+
+// Formato colunar binário para estatísticas por fluxo e por intervalo de tempo.
+// Não depende do ns-3: é usado tanto pelos cenários (escrita) quanto pelas ferramentas de
+// pós-processamento (leitura via mmap).
+//
+// Layout do arquivo (ordem de bytes nativa):
+//   FlowColumnHeader
+//   N blocos, um por intervalo: FlowColumnBucketHeader seguido das colunas, cada uma com
+//     nFlows valores: txBytes, rxBytes, delaySumNs, jitterSumNs (8 bytes) e
+//     flowId, txPackets, rxPackets, lostPackets (4 bytes)
+//   Tabela de fluxos (FlowColumnFlow[nFlows]) em header.flowTableOffset
+// Os valores de cada bloco são os incrementos do intervalo; o total é a soma dos blocos.
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+static const char FLOW_COLUMNS_MAGIC[8] = {'F', 'L', 'O', 'W', 'C', 'O', 'L', '1'};
+static const uint32_t FLOW_COLUMNS_VERSION = 1;
+
+struct FlowColumnHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t nFlows;           // fluxos na tabela de fluxos
+  uint64_t nBuckets;         // blocos de intervalo
+  uint64_t bucketNs;         // duração nominal de um intervalo
+  uint64_t flowTableOffset;  // 0 enquanto o arquivo não foi fechado
+};
+
+struct FlowColumnBucketHeader
+{
+  int64_t timeNs;  // fim do intervalo
+  uint32_t nFlows; // fluxos com atividade no intervalo
+  uint32_t reserved;
+};
+
+// 5-tupla de um fluxo (endereços IPv4 em ordem de host)
+struct FlowColumnFlow
+{
+  uint32_t flowId;
+  uint32_t sourceAddress;
+  uint32_t destinationAddress;
+  uint16_t sourcePort;
+  uint16_t destinationPort;
+  uint8_t protocol;
+  uint8_t reserved[3];
+};
+
+// Uma linha lógica (fluxo, intervalo) antes de ser transposta em colunas
+struct FlowColumnRow
+{
+  uint32_t flowId = 0;
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  uint32_t txPackets = 0;
+  uint32_t rxPackets = 0;
+  uint32_t lostPackets = 0;
+  int64_t delaySumNs = 0;
+  int64_t jitterSumNs = 0;
+};
+
+// Tamanho de um bloco com n fluxos (sempre múltiplo de 8)
+inline uint64_t FlowColumnBucketSize(uint32_t n)
+{
+  return sizeof(FlowColumnBucketHeader) + static_cast<uint64_t>(n) * (4 * 8 + 4 * 4);
+}
+
+// Escreve o arquivo bloco a bloco; só a tabela de fluxos fica em memória até Close()
+class FlowColumnWriter
+{
+public:
+  FlowColumnWriter(const std::string &fileName, uint64_t bucketNs)
+    : m_file(std::fopen(fileName.c_str(), "wb"))
+  {
+    std::memset(&m_header, 0, sizeof(m_header));
+    std::memcpy(m_header.magic, FLOW_COLUMNS_MAGIC, sizeof(m_header.magic));
+    m_header.version = FLOW_COLUMNS_VERSION;
+    m_header.bucketNs = bucketNs;
+    if (m_file) {
+      std::fwrite(&m_header, sizeof(m_header), 1, m_file);
+    }
+  }
+
+  ~FlowColumnWriter()
+  {
+    Close();
+  }
+
+  bool IsOpen() const
+  {
+    return m_file != nullptr;
+  }
+
+  void AppendBucket(int64_t timeNs, const std::vector<FlowColumnRow> &rows)
+  {
+    if (!m_file) {
+      return;
+    }
+    FlowColumnBucketHeader bucket = {timeNs, static_cast<uint32_t>(rows.size()), 0};
+    std::fwrite(&bucket, sizeof(bucket), 1, m_file);
+    WriteColumn<uint64_t>(rows, &FlowColumnRow::txBytes);
+    WriteColumn<uint64_t>(rows, &FlowColumnRow::rxBytes);
+    WriteColumn<int64_t>(rows, &FlowColumnRow::delaySumNs);
+    WriteColumn<int64_t>(rows, &FlowColumnRow::jitterSumNs);
+    WriteColumn<uint32_t>(rows, &FlowColumnRow::flowId);
+    WriteColumn<uint32_t>(rows, &FlowColumnRow::txPackets);
+    WriteColumn<uint32_t>(rows, &FlowColumnRow::rxPackets);
+    WriteColumn<uint32_t>(rows, &FlowColumnRow::lostPackets);
+    m_header.nBuckets++;
+  }
+
+  void SetFlow(const FlowColumnFlow &flow)
+  {
+    m_flows[flow.flowId] = flow;
+  }
+
+  // Grava a tabela de fluxos e atualiza o cabeçalho
+  void Close()
+  {
+    if (!m_file) {
+      return;
+    }
+    m_header.flowTableOffset = static_cast<uint64_t>(std::ftell(m_file));
+    m_header.nFlows = static_cast<uint32_t>(m_flows.size());
+    for (const auto &entry : m_flows) {
+      std::fwrite(&entry.second, sizeof(FlowColumnFlow), 1, m_file);
+    }
+    std::fseek(m_file, 0, SEEK_SET);
+    std::fwrite(&m_header, sizeof(m_header), 1, m_file);
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+
+private:
+  template <class T, class Member>
+  void WriteColumn(const std::vector<FlowColumnRow> &rows, Member member)
+  {
+    m_column.resize(rows.size() * sizeof(T));
+    T *values = reinterpret_cast<T *>(m_column.data());
+    for (size_t i = 0; i < rows.size(); i++) {
+      values[i] = static_cast<T>(rows[i].*member);
+    }
+    std::fwrite(m_column.data(), 1, m_column.size(), m_file);
+  }
+
+  std::FILE *m_file;
+  FlowColumnHeader m_header;
+  std::map<uint32_t, FlowColumnFlow> m_flows;
+  std::vector<char> m_column;
+};
+
+// Visão (sem cópia) de um bloco do arquivo mapeado
+struct FlowColumnBucket
+{
+  int64_t timeNs;
+  uint32_t nFlows;
+  const uint64_t *txBytes;
+  const uint64_t *rxBytes;
+  const int64_t *delaySumNs;
+  const int64_t *jitterSumNs;
+  const uint32_t *flowId;
+  const uint32_t *txPackets;
+  const uint32_t *rxPackets;
+  const uint32_t *lostPackets;
+};
+
+// Leitura do arquivo inteiro via mmap
+class FlowColumnReader
+{
+public:
+  FlowColumnReader()
+    : m_data(nullptr),
+      m_size(0)
+  {
+  }
+
+  ~FlowColumnReader()
+  {
+    if (m_data) {
+      munmap(const_cast<char *>(m_data), m_size);
+    }
+  }
+
+  FlowColumnReader(const FlowColumnReader &) = delete;
+  FlowColumnReader &operator=(const FlowColumnReader &) = delete;
+
+  // Retorna false se o arquivo não existe, está truncado ou não foi fechado pelo escritor
+  bool Open(const std::string &fileName)
+  {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FlowColumnHeader)) {
+      close(fd);
+      return false;
+    }
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      return false;
+    }
+    m_data = static_cast<const char *>(data);
+    m_size = st.st_size;
+    madvise(data, m_size, MADV_SEQUENTIAL);
+
+    const FlowColumnHeader &h = GetHeader();
+    return std::memcmp(h.magic, FLOW_COLUMNS_MAGIC, sizeof(h.magic)) == 0 &&
+           h.version == FLOW_COLUMNS_VERSION && h.flowTableOffset != 0 &&
+           h.flowTableOffset + h.nFlows * sizeof(FlowColumnFlow) <= m_size;
+  }
+
+  const FlowColumnHeader &GetHeader() const
+  {
+    return *reinterpret_cast<const FlowColumnHeader *>(m_data);
+  }
+
+  const FlowColumnFlow *GetFlows() const
+  {
+    return reinterpret_cast<const FlowColumnFlow *>(m_data + GetHeader().flowTableOffset);
+  }
+
+  // Chama fn(bucket) para cada bloco, em ordem
+  template <class Fn>
+  void ForEachBucket(Fn fn) const
+  {
+    uint64_t offset = sizeof(FlowColumnHeader);
+    uint64_t end = GetHeader().flowTableOffset;
+    for (uint64_t b = 0; b < GetHeader().nBuckets && offset < end; b++) {
+      const FlowColumnBucketHeader *h = reinterpret_cast<const FlowColumnBucketHeader *>(m_data + offset);
+      uint32_t n = h->nFlows;
+      if (offset + FlowColumnBucketSize(n) > end) {
+        break;
+      }
+      const char *p = m_data + offset + sizeof(FlowColumnBucketHeader);
+      FlowColumnBucket bucket;
+      bucket.timeNs = h->timeNs;
+      bucket.nFlows = n;
+      bucket.txBytes = reinterpret_cast<const uint64_t *>(p);
+      bucket.rxBytes = bucket.txBytes + n;
+      bucket.delaySumNs = reinterpret_cast<const int64_t *>(bucket.rxBytes + n);
+      bucket.jitterSumNs = bucket.delaySumNs + n;
+      bucket.flowId = reinterpret_cast<const uint32_t *>(bucket.jitterSumNs + n);
+      bucket.txPackets = bucket.flowId + n;
+      bucket.rxPackets = bucket.txPackets + n;
+      bucket.lostPackets = bucket.rxPackets + n;
+      fn(bucket);
+      offset += FlowColumnBucketSize(n);
+    }
+  }
+
+private:
+  const char *m_data;
+  size_t m_size;
+};
+
+} // namespace ns3
+
+#endif // FLOW_COLUMNS_H
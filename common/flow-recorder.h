@@ -0,0 +1,153 @@
+#ifndef FLOW_RECORDER_H
+#define FLOW_RECORDER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Estatísticas de um fluxo, com os mesmos nomes de campo do FlowMonitor::FlowStats, mas de tamanho
+// fixo: no lugar dos histogramas, os quantis do atraso
+struct FlowRecord
+{
+  FlowId flowId = 0;
+  uint32_t txPackets = 0;
+  uint32_t rxPackets = 0;
+  uint32_t lostPackets = 0;
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  Time timeFirstTxPacket;
+  Time timeLastTxPacket;
+  Time timeFirstRxPacket;
+  Time timeLastRxPacket;
+  Time delaySum;
+  Time jitterSum;
+  Time lastDelay;
+  double delayP50 = 0.0; // s
+  double delayP95 = 0.0;
+  double delayP99 = 0.0;
+};
+
+// Fonte das estatísticas por fluxo usada pelo cenário e pelas saídas (resumo, CSV, amostrador,
+// parada antecipada): o FlowMonitor do ns-3 (FlowMonitorRecorder) ou o CompactFlowMonitor
+class FlowRecorder : public SimpleRefCount<FlowRecorder>
+{
+public:
+  virtual ~FlowRecorder()
+  {
+  }
+
+  // Conta como perdidos os pacotes sem recepção há mais que o atraso máximo
+  virtual void CheckForLostPackets() = 0;
+
+  // Conta como perdidos todos os pacotes ainda sem recepção. Só vale com as filas vazias (rodada
+  // encerrada pelo esvaziamento), quando nenhum deles ainda pode chegar
+  virtual void FlushLostPackets() = 0;
+
+  // Um registro por fluxo, em ordem de FlowId; válido até a próxima chamada
+  virtual const std::vector<FlowRecord> &GetFlowRecords() = 0;
+
+  virtual Ptr<Ipv4FlowClassifier> GetClassifier() const = 0;
+
+  virtual void SerializeToXmlFile(const std::string &fileName, bool histograms, bool probes) = 0;
+};
+
+// Quantil q de um histograma do FlowMonitor, interpolado dentro da classe
+inline double HistogramQuantile(const Histogram &histogram, double q)
+{
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < histogram.GetNBins(); i++) {
+    total += histogram.GetBinCount(i);
+  }
+  if (total == 0) {
+    return 0.0;
+  }
+  double target = q * total;
+  double cumulative = 0.0;
+  for (uint32_t i = 0; i < histogram.GetNBins(); i++) {
+    uint32_t count = histogram.GetBinCount(i);
+    if (count > 0 && cumulative + count >= target) {
+      return histogram.GetBinStart(i) + histogram.GetBinWidth(i) * (target - cumulative) / count;
+    }
+    cumulative += count;
+  }
+  return histogram.GetBinEnd(histogram.GetNBins() - 1);
+}
+
+// FlowMonitor do ns-3 (sondas em todos os nós, histogramas e estatísticas por sonda)
+class FlowMonitorRecorder : public FlowRecorder
+{
+public:
+  explicit FlowMonitorRecorder(const NodeContainer &nodes)
+  {
+    m_monitor = m_helper.Install(nodes);
+    m_classifier = DynamicCast<Ipv4FlowClassifier>(m_helper.GetClassifier());
+  }
+
+  void CheckForLostPackets() override
+  {
+    m_monitor->CheckForLostPackets();
+  }
+
+  void FlushLostPackets() override
+  {
+    m_monitor->CheckForLostPackets(Seconds(0));
+  }
+
+  const std::vector<FlowRecord> &GetFlowRecords() override
+  {
+    m_records.clear();
+    for (const auto &entry : m_monitor->GetFlowStats()) {
+      const FlowMonitor::FlowStats &st = entry.second;
+      FlowRecord record;
+      record.flowId = entry.first;
+      record.txPackets = st.txPackets;
+      record.rxPackets = st.rxPackets;
+      record.lostPackets = st.lostPackets;
+      record.txBytes = st.txBytes;
+      record.rxBytes = st.rxBytes;
+      record.timeFirstTxPacket = st.timeFirstTxPacket;
+      record.timeLastTxPacket = st.timeLastTxPacket;
+      record.timeFirstRxPacket = st.timeFirstRxPacket;
+      record.timeLastRxPacket = st.timeLastRxPacket;
+      record.delaySum = st.delaySum;
+      record.jitterSum = st.jitterSum;
+      record.lastDelay = st.lastDelay;
+      record.delayP50 = HistogramQuantile(st.delayHistogram, 0.50);
+      record.delayP95 = HistogramQuantile(st.delayHistogram, 0.95);
+      record.delayP99 = HistogramQuantile(st.delayHistogram, 0.99);
+      m_records.push_back(record);
+    }
+    return m_records;
+  }
+
+  Ptr<Ipv4FlowClassifier> GetClassifier() const override
+  {
+    return m_classifier;
+  }
+
+  void SerializeToXmlFile(const std::string &fileName, bool histograms, bool probes) override
+  {
+    m_monitor->SerializeToXmlFile(fileName, histograms, probes);
+  }
+
+  Ptr<FlowMonitor> GetMonitor() const
+  {
+    return m_monitor;
+  }
+
+private:
+  FlowMonitorHelper m_helper;
+  Ptr<FlowMonitor> m_monitor;
+  Ptr<Ipv4FlowClassifier> m_classifier;
+  std::vector<FlowRecord> m_records;
+};
+
+} // namespace ns3
+
+#endif // FLOW_RECORDER_H
@@ -0,0 +1,152 @@
+#ifndef FLOW_STATS_SAMPLER_H
+#define FLOW_STATS_SAMPLER_H
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include "flow-columns.h"
+#include "flow-recorder.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Amostra periodicamente as estatísticas por fluxo (FlowRecorder) e grava, para cada fluxo com
+// atividade no intervalo, os incrementos desde a amostra anterior: uma linha CSV por fluxo
+// ("csv") ou um bloco do formato colunar de flow-columns.h ("columns"). Só guarda o último
+// valor acumulado de cada fluxo, então a memória não cresce com a duração da simulação.
+class FlowStatsSampler
+{
+public:
+  FlowStatsSampler(Ptr<FlowRecorder> recorder, Time interval, const std::string &fileName,
+                   const std::string &format)
+    : m_recorder(recorder),
+      m_classifier(recorder->GetClassifier()),
+      m_interval(interval),
+      m_lastSample(Simulator::Now())
+  {
+    if (format == "columns") {
+      m_columns.reset(new FlowColumnWriter(fileName, interval.GetNanoSeconds()));
+      NS_ABORT_MSG_UNLESS(m_columns->IsOpen(), "Não foi possível criar " << fileName);
+    } else {
+      NS_ABORT_MSG_UNLESS(format == "csv", "Formato de amostra desconhecido: " << format);
+      m_out.open(fileName);
+      NS_ABORT_MSG_UNLESS(m_out, "Não foi possível criar " << fileName);
+      m_out << "timeS,flowId,txPackets,rxPackets,txBytes,rxBytes,lostPackets,"
+            << "throughputMbps,meanDelayMs,meanJitterMs\n";
+    }
+    m_event = Simulator::Schedule(m_interval, &FlowStatsSampler::Sample, this);
+  }
+
+  // Grava a última amostra (parcial) e fecha o arquivo
+  void Finish()
+  {
+    m_event.Cancel();
+    if (m_out.is_open()) {
+      WriteSample();
+      m_out.close();
+    }
+    if (m_columns) {
+      WriteSample();
+      for (const auto &entry : m_last) {
+        Ipv4FlowClassifier::FiveTuple t = m_classifier->FindFlow(entry.first);
+        FlowColumnFlow flow = {};
+        flow.flowId = entry.first;
+        flow.sourceAddress = t.sourceAddress.Get();
+        flow.destinationAddress = t.destinationAddress.Get();
+        flow.sourcePort = t.sourcePort;
+        flow.destinationPort = t.destinationPort;
+        flow.protocol = t.protocol;
+        m_columns->SetFlow(flow);
+      }
+      m_columns->Close();
+      m_columns.reset();
+    }
+  }
+
+private:
+  // Valores acumulados do fluxo na amostra anterior
+  struct Snapshot
+  {
+    uint64_t txBytes = 0;
+    uint64_t rxBytes = 0;
+    uint32_t txPackets = 0;
+    uint32_t rxPackets = 0;
+    uint32_t lostPackets = 0;
+    Time delaySum;
+    Time jitterSum;
+  };
+
+  void Sample()
+  {
+    WriteSample();
+    m_event = Simulator::Schedule(m_interval, &FlowStatsSampler::Sample, this);
+  }
+
+  void WriteSample()
+  {
+    Time now = Simulator::Now();
+    double elapsed = (now - m_lastSample).GetSeconds();
+    m_lastSample = now;
+
+    m_rows.clear();
+    m_recorder->CheckForLostPackets();
+    for (const FlowRecord &st : m_recorder->GetFlowRecords()) {
+      Snapshot &last = m_last[st.flowId];
+
+      FlowColumnRow row;
+      row.flowId = st.flowId;
+      row.txPackets = st.txPackets - last.txPackets;
+      row.rxPackets = st.rxPackets - last.rxPackets;
+      row.lostPackets = st.lostPackets - last.lostPackets;
+      if (row.txPackets == 0 && row.rxPackets == 0 && row.lostPackets == 0) {
+        continue;
+      }
+      row.txBytes = st.txBytes - last.txBytes;
+      row.rxBytes = st.rxBytes - last.rxBytes;
+      row.delaySumNs = (st.delaySum - last.delaySum).GetNanoSeconds();
+      row.jitterSumNs = (st.jitterSum - last.jitterSum).GetNanoSeconds();
+      m_rows.push_back(row);
+
+      last.txBytes = st.txBytes;
+      last.rxBytes = st.rxBytes;
+      last.txPackets = st.txPackets;
+      last.rxPackets = st.rxPackets;
+      last.lostPackets = st.lostPackets;
+      last.delaySum = st.delaySum;
+      last.jitterSum = st.jitterSum;
+    }
+
+    if (m_columns) {
+      m_columns->AppendBucket(now.GetNanoSeconds(), m_rows);
+      return;
+    }
+    for (const FlowColumnRow &row : m_rows) {
+      double throughput = elapsed > 0 ? row.rxBytes * 8.0 / elapsed / 1e6 : 0.0;
+      double delay = row.rxPackets > 0 ? row.delaySumNs / 1e6 / row.rxPackets : 0.0;
+      double jitter = row.rxPackets > 0 ? row.jitterSumNs / 1e6 / row.rxPackets : 0.0;
+      m_out << now.GetSeconds() << "," << row.flowId << "," << row.txPackets << "," << row.rxPackets << ","
+            << row.txBytes << "," << row.rxBytes << "," << row.lostPackets << ","
+            << throughput << "," << delay << "," << jitter << "\n";
+    }
+  }
+
+  Ptr<FlowRecorder> m_recorder;
+  Ptr<Ipv4FlowClassifier> m_classifier;
+  Time m_interval;
+  Time m_lastSample;
+  std::ofstream m_out;
+  std::unique_ptr<FlowColumnWriter> m_columns;
+  std::map<FlowId, Snapshot> m_last;
+  std::vector<FlowColumnRow> m_rows;
+  EventId m_event;
+};
+
+} // namespace ns3
+
+#endif // FLOW_STATS_SAMPLER_H
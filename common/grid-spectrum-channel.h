@@ -0,0 +1,222 @@
+#ifndef GRID_SPECTRUM_CHANNEL_H
+#define GRID_SPECTRUM_CHANNEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+#include "ns3/spectrum-module.h"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+// Canal espectral compartilhado com índice espacial em grade. O SingleModelSpectrumChannel
+// entrega cada quadro a todos os PHYs conectados (O(N) por quadro); aqui só são visitados os
+// PHYs das 3 x 3 células da grade em volta do transmissor, e apenas os que estão dentro do
+// alcance ("Range") recebem o sinal. Com vários APs espalhados num campus o custo por quadro
+// passa a depender do número de vizinhos e não do total de nós.
+//
+// O índice é reconstruído a cada "IndexRefresh"; como os nós podem ter andado até
+// MaxSpeed * IndexRefresh desde então, o lado da célula da grade inclui essa folga. A distância
+// usada no corte é sempre a posição atual. Antenas são tratadas como isotrópicas (caso do Wi-Fi).
+class GridSpectrumChannel : public SpectrumChannel
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid =
+        TypeId("ns3::GridSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<GridSpectrumChannel>()
+            .AddAttribute("Range", "Distância máxima (m) em que um receptor recebe o sinal",
+                          DoubleValue(250.0),
+                          MakeDoubleAccessor(&GridSpectrumChannel::m_range),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxSpeed", "Maior velocidade (m/s) de um nó conectado ao canal",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&GridSpectrumChannel::m_maxSpeed),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("IndexRefresh", "Intervalo entre reconstruções do índice espacial",
+                          TimeValue(Seconds(1.0)),
+                          MakeTimeAccessor(&GridSpectrumChannel::m_refresh),
+                          MakeTimeChecker());
+    return tid;
+  }
+
+  GridSpectrumChannel()
+    : m_range(250.0),
+      m_maxSpeed(0.0),
+      m_cellSize(0.0),
+      m_dirty(true),
+      m_visited(0),
+      m_delivered(0),
+      m_skipped(0)
+  {
+  }
+
+  void AddRx(Ptr<SpectrumPhy> phy) override
+  {
+    m_phys.push_back(phy);
+    m_dirty = true;
+  }
+
+  void RemoveRx(Ptr<SpectrumPhy> phy) override
+  {
+    for (auto it = m_phys.begin(); it != m_phys.end(); ++it) {
+      if (*it == phy) {
+        m_phys.erase(it);
+        break;
+      }
+    }
+    m_dirty = true;
+  }
+
+  void StartTx(Ptr<SpectrumSignalParameters> txParams) override
+  {
+    if (m_dirty || Simulator::Now() - m_indexTime >= m_refresh) {
+      RebuildIndex();
+    }
+
+    Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Vector position = senderMobility->GetPosition();
+    int64_t cx = CellOf(position.x);
+    int64_t cy = CellOf(position.y);
+
+    for (int64_t dx = -1; dx <= 1; dx++) {
+      for (int64_t dy = -1; dy <= 1; dy++) {
+        auto cell = m_grid.find(Key(cx + dx, cy + dy));
+        if (cell == m_grid.end()) {
+          continue;
+        }
+        for (const Ptr<SpectrumPhy> &rx : cell->second) {
+          if (rx != txParams->txPhy) {
+            Deliver(txParams, senderMobility, rx);
+          }
+        }
+      }
+    }
+    m_skipped += m_phys.size() - 1 - m_visited;
+    m_visited = 0;
+  }
+
+  std::size_t GetNDevices() const override
+  {
+    return m_phys.size();
+  }
+
+  Ptr<NetDevice> GetDevice(std::size_t i) const override
+  {
+    return m_phys.at(i)->GetDevice();
+  }
+
+  // Sinais entregues a receptores e receptores descartados sem nem calcular a perda
+  uint64_t GetDelivered() const
+  {
+    return m_delivered;
+  }
+
+  uint64_t GetSkipped() const
+  {
+    return m_skipped;
+  }
+
+private:
+  void Deliver(Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> senderMobility,
+               Ptr<SpectrumPhy> rx)
+  {
+    m_visited++;
+    Ptr<MobilityModel> receiverMobility = rx->GetMobility();
+    if (senderMobility->GetDistanceFrom(receiverMobility) > m_range) {
+      return;
+    }
+
+    Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    if (m_propagationLoss) {
+      double gainDb = m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
+      if (-gainDb > m_maxLossDb) {
+        return;
+      }
+      *(rxParams->psd) *= std::pow(10.0, gainDb / 10.0);
+      m_pathLossTrace(txParams->txPhy, rx, -gainDb);
+    }
+    if (m_spectrumPropagationLoss) {
+      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(rxParams, senderMobility,
+                                                                             receiverMobility);
+    }
+
+    Time delay = m_propagationDelay ? m_propagationDelay->GetDelay(senderMobility, receiverMobility)
+                                    : Seconds(0);
+    Ptr<NetDevice> device = rx->GetDevice();
+    uint32_t context = device ? device->GetNode()->GetId() : Simulator::NO_CONTEXT;
+    Simulator::ScheduleWithContext(context, delay, &SpectrumPhy::StartRx, rx, rxParams);
+    m_delivered++;
+  }
+
+  void RebuildIndex()
+  {
+    m_cellSize = m_range + m_maxSpeed * m_refresh.GetSeconds();
+    m_grid.clear();
+    for (const Ptr<SpectrumPhy> &phy : m_phys) {
+      Ptr<MobilityModel> mobility = phy->GetMobility();
+      if (!mobility) {
+        continue;
+      }
+      Vector position = mobility->GetPosition();
+      m_grid[Key(CellOf(position.x), CellOf(position.y))].push_back(phy);
+    }
+    m_indexTime = Simulator::Now();
+    m_dirty = false;
+  }
+
+  int64_t CellOf(double coordinate) const
+  {
+    return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+  }
+
+  static uint64_t Key(int64_t x, int64_t y)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+  }
+
+  std::vector<Ptr<SpectrumPhy>> m_phys;
+  std::unordered_map<uint64_t, std::vector<Ptr<SpectrumPhy>>> m_grid;
+  double m_range;
+  double m_maxSpeed;
+  double m_cellSize;
+  Time m_refresh;
+  Time m_indexTime;
+  bool m_dirty;
+  uint64_t m_visited;
+  uint64_t m_delivered;
+  uint64_t m_skipped;
+};
+
+// Maior distância em que um sinal de txPowerDbm ainda chega com pelo menos sensitivityDbm,
+// por bisseção sobre um modelo de perda determinístico e monotônico (ex.: LogDistance)
+inline double SensitivityRange(Ptr<PropagationLossModel> loss, double txPowerDbm, double sensitivityDbm)
+{
+  Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+  Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+  a->SetPosition(Vector(0.0, 0.0, 0.0));
+  double low = 1.0;
+  double high = 1e5;
+  for (int i = 0; i < 60; i++) {
+    double middle = (low + high) / 2;
+    b->SetPosition(Vector(middle, 0.0, 0.0));
+    if (loss->CalcRxPower(txPowerDbm, a, b) >= sensitivityDbm) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
+}
+
+} // namespace ns3
+
+#endif // GRID_SPECTRUM_CHANNEL_H
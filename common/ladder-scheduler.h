@@ -0,0 +1,233 @@
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Escalonador em escada (ladder queue, Tang et al. 2005). Os eventos ficam em três níveis:
+//  - Top: lista sem ordem com os eventos mais distantes (ts >= m_topStart);
+//  - Rungs: degraus de baldes de largura fixa; um balde com muitos eventos vira um degrau
+//    mais fino, até MAX_RUNGS degraus;
+//  - Bottom: os poucos eventos mais próximos, ordenados (o menor no fim do vetor).
+// Inserir custa O(1) fora do Bottom e a ordenação só acontece em lotes pequenos, então o custo
+// por evento fica quase constante com muitos eventos pendentes (ex.: dezenas de fontes OnOff e
+// temporizadores do Wi-Fi). Eventos com o mesmo instante saem na ordem do uid, como no MapScheduler.
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+  }
+
+  LadderScheduler()
+    : m_size(0),
+      m_topStart(0),
+      m_topMin(UINT64_MAX),
+      m_topMax(0)
+  {
+  }
+
+  void Insert(const Event &ev) override
+  {
+    m_size++;
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart) {
+      m_top.push_back(ev);
+      m_topMin = std::min(m_topMin, ts);
+      m_topMax = std::max(m_topMax, ts);
+      return;
+    }
+    for (Rung &rung : m_rungs) {
+      if (ts >= rung.current) {
+        rung.buckets[(ts - rung.start) / rung.width].push_back(ev);
+        rung.count++;
+        return;
+      }
+    }
+    m_bottom.insert(std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, Later()), ev);
+  }
+
+  bool IsEmpty() const override
+  {
+    return m_size == 0;
+  }
+
+  Event PeekNext() const override
+  {
+    const_cast<LadderScheduler *>(this)->FillBottom();
+    return m_bottom.back();
+  }
+
+  Event RemoveNext() override
+  {
+    FillBottom();
+    Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    return ev;
+  }
+
+  void Remove(const Event &ev) override
+  {
+    m_size--;
+    if (!m_bottom.empty() && !(m_bottom.front().key < ev.key) && !(ev.key < m_bottom.back().key)) {
+      if (Erase(m_bottom, ev)) {
+        return;
+      }
+    }
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart) {
+      Erase(m_top, ev);
+      return;
+    }
+    for (Rung &rung : m_rungs) {
+      if (ts >= rung.current) {
+        Erase(rung.buckets[(ts - rung.start) / rung.width], ev);
+        rung.count--;
+        return;
+      }
+    }
+    Erase(m_bottom, ev);
+  }
+
+private:
+  // Acima disso um balde é dividido em um novo degrau em vez de ir ordenado para o Bottom
+  static const uint32_t SPLIT_THRESHOLD = 50;
+  static const uint32_t MAX_RUNGS = 8;
+
+  struct Rung
+  {
+    uint64_t start;   // início do primeiro balde
+    uint64_t width;   // largura de cada balde
+    uint64_t current; // início do primeiro balde ainda não consumido
+    uint64_t count;   // eventos no degrau
+    std::vector<std::vector<Event>> buckets;
+
+    uint64_t End() const
+    {
+      return start + width * buckets.size();
+    }
+  };
+
+  // Ordem decrescente: o próximo evento fica no fim do vetor
+  struct Later
+  {
+    bool operator()(const Event &a, const Event &b) const
+    {
+      return b.key < a.key;
+    }
+  };
+
+  static bool Erase(std::vector<Event> &events, const Event &ev)
+  {
+    for (auto it = events.begin(); it != events.end(); ++it) {
+      if (it->key.m_uid == ev.key.m_uid) {
+        events.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Cria um degrau com baldes de largura "width" cobrindo [start, start + span) e distribui os eventos
+  void AddRung(uint64_t start, uint64_t span, uint64_t width, std::vector<Event> &events)
+  {
+    Rung rung;
+    rung.start = start;
+    rung.width = width;
+    rung.current = start;
+    rung.count = events.size();
+    rung.buckets.resize((span + width - 1) / width);
+    for (const Event &ev : events) {
+      rung.buckets[(ev.key.m_ts - start) / width].push_back(ev);
+    }
+    events.clear();
+    m_rungs.push_back(std::move(rung));
+  }
+
+  // Garante que o Bottom tenha o próximo evento (só chamado com m_size > 0)
+  void FillBottom()
+  {
+    while (m_bottom.empty()) {
+      if (m_rungs.empty()) {
+        // Todo o Top vira o primeiro degrau, com cerca de um evento por balde
+        uint64_t width = (m_topMax - m_topMin) / m_top.size() + 1;
+        uint64_t start = m_topMin;
+        m_topStart = start + width * m_top.size();
+        m_topMin = UINT64_MAX;
+        m_topMax = 0;
+        AddRung(start, m_topStart - start, width, m_top);
+        continue;
+      }
+
+      Rung &rung = m_rungs.back();
+      if (rung.count == 0) {
+        m_rungs.pop_back();
+        continue;
+      }
+      uint64_t index = (rung.current - rung.start) / rung.width;
+      while (rung.buckets[index].empty()) {
+        index++;
+      }
+      std::vector<Event> bucket;
+      bucket.swap(rung.buckets[index]);
+      uint64_t bucketStart = rung.start + index * rung.width;
+      rung.current = bucketStart + rung.width;
+      rung.count -= bucket.size();
+
+      if (bucket.size() > SPLIT_THRESHOLD && rung.width > 1 && m_rungs.size() < MAX_RUNGS) {
+        uint64_t width = (rung.width + bucket.size() - 1) / bucket.size();
+        AddRung(bucketStart, rung.width, width, bucket);
+      } else {
+        std::sort(bucket.begin(), bucket.end(), Later());
+        m_bottom.swap(bucket);
+      }
+    }
+  }
+
+  uint64_t m_size;
+  std::vector<Event> m_top;
+  uint64_t m_topStart; // eventos com ts >= m_topStart vão para o Top
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  std::vector<Rung> m_rungs;
+  std::vector<Event> m_bottom;
+};
+
+// Nome curto da linha de comando -> TypeId do escalonador ("map", "heap", "list", "calendar",
+// "ladder" ou o nome completo de qualquer ns3::Scheduler)
+inline std::string SchedulerTypeName(const std::string &name)
+{
+  if (name == "map") {
+    return "ns3::MapScheduler";
+  }
+  if (name == "heap") {
+    return "ns3::HeapScheduler";
+  }
+  if (name == "list") {
+    return "ns3::ListScheduler";
+  }
+  if (name == "calendar") {
+    return "ns3::CalendarScheduler";
+  }
+  if (name == "ladder") {
+    return LadderScheduler::GetTypeId().GetName();
+  }
+  return name;
+}
+
+} // namespace ns3
+
+#endif // LADDER_SCHEDULER_H
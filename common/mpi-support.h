@@ -0,0 +1,114 @@
+#ifndef MPI_SUPPORT_H
+#define MPI_SUPPORT_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <cstring>
+#include <string>
+
+namespace ns3 {
+
+// Execução distribuída com MPI: o servidor fica no processo 0 e as células são repartidas
+// entre os demais processos. Os únicos enlaces entre processos são os P2P AP–servidor, então
+// o lookahead do simulador distribuído é o atraso desse enlace (p2pDelay, 2 ms por padrão).
+// Sem MPI (ou com um único processo) tudo roda no processo 0, como na execução sequencial.
+class DistributedRun
+{
+public:
+  // Precisa ser chamado antes de qualquer nó ou evento ser criado
+  static void Enable(int *argc, char ***argv)
+  {
+#ifdef NS3_MPI
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DistributedSimulatorImpl"));
+    MpiInterface::Enable(argc, argv);
+#else
+    NS_FATAL_ERROR("--distributed requer o ns-3 configurado com --enable-mpi");
+#endif
+  }
+
+  static void Disable()
+  {
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled()) {
+      MpiInterface::Disable();
+    }
+#endif
+  }
+
+  static bool IsEnabled()
+  {
+#ifdef NS3_MPI
+    return MpiInterface::IsEnabled();
+#else
+    return false;
+#endif
+  }
+
+  static uint32_t GetRank()
+  {
+#ifdef NS3_MPI
+    return IsEnabled() ? MpiInterface::GetSystemId() : 0;
+#else
+    return 0;
+#endif
+  }
+
+  static uint32_t GetSize()
+  {
+#ifdef NS3_MPI
+    return IsEnabled() ? MpiInterface::GetSize() : 1;
+#else
+    return 1;
+#endif
+  }
+
+  static uint32_t ServerRank()
+  {
+    return 0;
+  }
+
+  // Processo responsável pela célula: 1..size-1 em rodízio (ou 0 se houver um só processo)
+  static uint32_t CellRank(uint32_t cell)
+  {
+    uint32_t size = GetSize();
+    return size <= 1 ? 0 : 1 + cell % (size - 1);
+  }
+
+  static bool IsLocal(Ptr<Node> node)
+  {
+    return node->GetSystemId() == GetRank();
+  }
+
+  static NodeContainer LocalNodes(const NodeContainer &nodes)
+  {
+    NodeContainer local;
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      if (IsLocal(nodes.Get(i))) {
+        local.Add(nodes.Get(i));
+      }
+    }
+    return local;
+  }
+
+  // Procura "--distributed" (ou "--distributed=1|true") antes do CommandLine, porque o MPI
+  // precisa ser habilitado antes de o resto dos argumentos ser interpretado
+  static bool Requested(int argc, char *argv[])
+  {
+    for (int i = 1; i < argc; i++) {
+      if (std::strcmp(argv[i], "--distributed") == 0 || std::strcmp(argv[i], "--distributed=1") == 0 ||
+          std::strcmp(argv[i], "--distributed=true") == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace ns3
+
+#endif // MPI_SUPPORT_H
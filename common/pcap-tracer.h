@@ -0,0 +1,223 @@
+#ifndef PCAP_TRACER_H
+#define PCAP_TRACER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+
+// Captura PCAP seletiva e de custo limitado: só os dispositivos passados a Install(), só os
+// pacotes dentro da janela [start, stop] e só os primeiros snapLen bytes de cada um. Os registros
+// são montados num buffer por arquivo e, a cada FLUSH_BYTES, entregues a uma única thread que
+// grava no disco; a simulação só espera se a thread ficar MAX_QUEUED_BYTES atrás. Wi-Fi: quadros
+// 802.11 sem radiotap (DLT_IEEE802_11, como o YansWifiPhyHelper); P2P: PPP (DLT_PPP). Os
+// arquivos seguem o nome do ns-3: <prefixo>-<nó>-<dispositivo>.pcap.
+class PcapTracer
+{
+public:
+  PcapTracer(const std::string &prefix, uint32_t snapLen, Time start, Time stop)
+    : m_prefix(prefix),
+      m_snapLen(snapLen),
+      m_start(start),
+      m_stop(stop),
+      m_records(0),
+      m_queuedBytes(0),
+      m_closing(false)
+  {
+    m_thread = std::thread(&PcapTracer::WriterLoop, this);
+  }
+
+  ~PcapTracer()
+  {
+    Close();
+  }
+
+  // Captura os quadros transmitidos e recebidos pelo dispositivo (Wi-Fi ou P2P; os demais são ignorados)
+  void Install(Ptr<NetDevice> device)
+  {
+    std::string name = m_prefix + "-" + std::to_string(device->GetNode()->GetId()) + "-" +
+                       std::to_string(device->GetIfIndex()) + ".pcap";
+    if (Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(device)) {
+      File *file = Open(name, DLT_IEEE802_11);
+      wifi->GetPhy()->TraceConnectWithoutContext("MonitorSnifferTx", MakeBoundCallback(&PcapTracer::WifiTx, file));
+      wifi->GetPhy()->TraceConnectWithoutContext("MonitorSnifferRx", MakeBoundCallback(&PcapTracer::WifiRx, file));
+    } else if (Ptr<PointToPointNetDevice> p2p = DynamicCast<PointToPointNetDevice>(device)) {
+      File *file = Open(name, DLT_PPP);
+      p2p->TraceConnectWithoutContext("PromiscSniffer", MakeBoundCallback(&PcapTracer::Sniff, file));
+    }
+  }
+
+  // Grava o que falta e fecha os arquivos; os quadros posteriores são descartados
+  void Close()
+  {
+    if (!m_thread.joinable()) {
+      return;
+    }
+    for (const std::unique_ptr<File> &file : m_files) {
+      Submit(*file);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closing = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    for (const std::unique_ptr<File> &file : m_files) {
+      std::fclose(file->fp);
+      file->fp = nullptr;
+    }
+  }
+
+  uint64_t GetRecords() const
+  {
+    return m_records;
+  }
+
+private:
+  static const uint32_t DLT_PPP = 9;
+  static const uint32_t DLT_IEEE802_11 = 105;
+  static const size_t FLUSH_BYTES = 1 << 20;
+  static const size_t MAX_QUEUED_BYTES = 64 << 20;
+
+  struct File
+  {
+    PcapTracer *tracer;
+    std::FILE *fp;
+    std::vector<uint8_t> buffer;
+  };
+
+  struct Chunk
+  {
+    std::FILE *fp;
+    std::vector<uint8_t> data;
+  };
+
+  File *Open(const std::string &name, uint32_t linkType)
+  {
+    std::FILE *fp = std::fopen(name.c_str(), "wb");
+    NS_ABORT_MSG_UNLESS(fp, "Não foi possível criar " << name);
+    // Cabeçalho global do formato pcap (versão 2.4, ordem de bytes da máquina)
+    struct
+    {
+      uint32_t magic;
+      uint16_t versionMajor;
+      uint16_t versionMinor;
+      int32_t thisZone;
+      uint32_t sigFigs;
+      uint32_t snapLen;
+      uint32_t linkType;
+    } header = {0xa1b2c3d4, 2, 4, 0, 0, m_snapLen, linkType};
+    std::fwrite(&header, sizeof(header), 1, fp);
+
+    m_files.push_back(std::unique_ptr<File>(new File{this, fp, {}}));
+    m_files.back()->buffer.reserve(FLUSH_BYTES + m_snapLen + 16);
+    return m_files.back().get();
+  }
+
+  static void Sniff(File *file, Ptr<const Packet> packet)
+  {
+    file->tracer->Record(*file, packet);
+  }
+
+  static void WifiTx(File *file, Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector,
+                     MpduInfo aMpdu, uint16_t staId)
+  {
+    file->tracer->Record(*file, packet);
+  }
+
+  static void WifiRx(File *file, Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector,
+                     MpduInfo aMpdu, SignalNoiseDbm signalNoise, uint16_t staId)
+  {
+    file->tracer->Record(*file, packet);
+  }
+
+  void Record(File &file, Ptr<const Packet> packet)
+  {
+    Time now = Simulator::Now();
+    if (!file.fp || now < m_start || (m_stop.IsStrictlyPositive() && now > m_stop)) {
+      return;
+    }
+    uint32_t size = packet->GetSize();
+    uint32_t captured = std::min(size, m_snapLen);
+    int64_t us = now.GetMicroSeconds();
+    uint32_t header[4] = {static_cast<uint32_t>(us / 1000000), static_cast<uint32_t>(us % 1000000), captured, size};
+
+    size_t offset = file.buffer.size();
+    file.buffer.resize(offset + sizeof(header) + captured);
+    std::memcpy(file.buffer.data() + offset, header, sizeof(header));
+    packet->CopyData(file.buffer.data() + offset + sizeof(header), captured);
+    m_records++;
+
+    if (file.buffer.size() >= FLUSH_BYTES) {
+      Submit(file);
+    }
+  }
+
+  // Entrega o buffer do arquivo à thread de escrita
+  void Submit(File &file)
+  {
+    if (file.buffer.empty()) {
+      return;
+    }
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_drained.wait(lock, [this] { return m_queuedBytes < MAX_QUEUED_BYTES; });
+      m_queuedBytes += file.buffer.size();
+      m_queue.push_back({file.fp, std::move(file.buffer)});
+    }
+    m_wake.notify_one();
+    file.buffer = std::vector<uint8_t>();
+    file.buffer.reserve(FLUSH_BYTES + m_snapLen + 16);
+  }
+
+  void WriterLoop()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_wake.wait(lock, [this] { return !m_queue.empty() || m_closing; });
+      if (m_queue.empty()) {
+        return;
+      }
+      Chunk chunk = std::move(m_queue.front());
+      m_queue.pop_front();
+      lock.unlock();
+      std::fwrite(chunk.data.data(), 1, chunk.data.size(), chunk.fp);
+      lock.lock();
+      m_queuedBytes -= chunk.data.size();
+      m_drained.notify_one();
+    }
+  }
+
+  std::string m_prefix;
+  uint32_t m_snapLen;
+  Time m_start;
+  Time m_stop; // zero: até o fim da rodada
+  uint64_t m_records;
+  std::vector<std::unique_ptr<File>> m_files;
+
+  // Compartilhados com a thread de escrita (protegidos por m_mutex)
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_drained;
+  std::deque<Chunk> m_queue;
+  size_t m_queuedBytes;
+  bool m_closing;
+  std::thread m_thread;
+};
+
+} // namespace ns3
+
+#endif // PCAP_TRACER_H
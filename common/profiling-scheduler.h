@@ -0,0 +1,232 @@
+#ifndef PROFILING_SCHEDULER_H
+#define PROFILING_SCHEDULER_H
+
+#include "ns3/core-module.h"
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+// Escalonador que envolve outro ("InnerScheduler") e mede, por tipo de evento, quantas vezes ele
+// rodou e o tempo de parede gasto nele: do RemoveNext() que o entregou ao simulador até a próxima
+// consulta ao escalonador. O tempo dos Insert() feitos dentro do evento é separado, assim como o
+// do próprio RemoveNext(). O tipo do evento é a classe criada por MakeEvent, que traz a classe e
+// a assinatura do método agendado (ex.: "ns3::Txop" / "void (ns3::Txop::*)()").
+//
+// No Simulator::Destroy() grava "OutputFile" no formato "folded" do flamegraph.pl
+// (pilha separada por ';' e microssegundos) e "<OutputFile>.csv" com o resumo por tipo.
+class ProfilingScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid =
+        TypeId("ns3::ProfilingScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<ProfilingScheduler>()
+            .AddAttribute("InnerScheduler", "Escalonador que guarda os eventos",
+                          StringValue("ns3::MapScheduler"),
+                          MakeStringAccessor(&ProfilingScheduler::SetInnerScheduler),
+                          MakeStringChecker())
+            .AddAttribute("OutputFile", "Arquivo folded gravado no Simulator::Destroy()",
+                          StringValue("profile.folded"),
+                          MakeStringAccessor(&ProfilingScheduler::m_outputFile),
+                          MakeStringChecker());
+    return tid;
+  }
+
+  ProfilingScheduler()
+    : m_current(nullptr),
+      m_removeNextNs(0),
+      m_registered(false),
+      m_finished(false)
+  {
+    SetInnerScheduler("ns3::MapScheduler");
+  }
+
+  void Insert(const Event &ev) override
+  {
+    if (!m_registered) {
+      // O Destroy() esvazia o escalonador depois dos eventos de destruição, então o relatório
+      // sai antes disso e as remoções da limpeza não são contadas
+      m_registered = true;
+      Simulator::ScheduleDestroy(&ProfilingScheduler::Finish, this);
+    }
+    if (!m_current || m_finished) {
+      m_inner->Insert(ev);
+      return;
+    }
+    Clock::time_point start = Clock::now();
+    m_inner->Insert(ev);
+    m_current->inserts++;
+    m_current->insertNs += Elapsed(start, Clock::now());
+  }
+
+  bool IsEmpty() const override
+  {
+    EndCurrent();
+    return m_inner->IsEmpty();
+  }
+
+  Event PeekNext() const override
+  {
+    return m_inner->PeekNext();
+  }
+
+  Event RemoveNext() override
+  {
+    EndCurrent();
+    if (m_finished) {
+      return m_inner->RemoveNext();
+    }
+    Clock::time_point start = Clock::now();
+    Event ev = m_inner->RemoveNext();
+    m_start = Clock::now();
+    m_removeNextNs += Elapsed(start, m_start);
+    m_current = &m_stats[std::type_index(typeid(*ev.impl))];
+    m_current->count++;
+    return ev;
+  }
+
+  void Remove(const Event &ev) override
+  {
+    m_inner->Remove(ev);
+  }
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Stats
+  {
+    uint64_t count = 0;
+    uint64_t totalNs = 0; // inclui insertNs
+    uint64_t inserts = 0;
+    uint64_t insertNs = 0;
+  };
+
+  static uint64_t Elapsed(Clock::time_point from, Clock::time_point to)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+  }
+
+  void SetInnerScheduler(std::string type)
+  {
+    ObjectFactory factory;
+    factory.SetTypeId(type);
+    m_inner = factory.Create<Scheduler>();
+  }
+
+  // Fecha o intervalo do evento em execução (se houver)
+  void EndCurrent() const
+  {
+    if (m_current) {
+      m_current->totalNs += Elapsed(m_start, Clock::now());
+      m_current = nullptr;
+    }
+  }
+
+  static std::string Demangle(const char *name)
+  {
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string result = status == 0 && demangled ? demangled : name;
+    std::free(demangled);
+    return result;
+  }
+
+  // Primeiro argumento de "ns3::MakeEvent<...>": o tipo da função ou do método agendado
+  static std::string Signature(const std::string &name)
+  {
+    std::string::size_type begin = name.find("MakeEvent<");
+    if (begin == std::string::npos) {
+      return name;
+    }
+    begin += 10;
+    int depth = 0;
+    for (std::string::size_type i = begin; i < name.size(); i++) {
+      char c = name[i];
+      if (c == '<' || c == '(') {
+        depth++;
+      } else if ((c == '>' || c == ')') && depth > 0) {
+        depth--;
+      } else if ((c == ',' || c == '>') && depth == 0) {
+        return name.substr(begin, i - begin);
+      }
+    }
+    return name.substr(begin);
+  }
+
+  // Classe do método agendado ("void (ns3::Txop::*)()" -> "ns3::Txop")
+  static std::string Owner(const std::string &signature)
+  {
+    std::string::size_type end = signature.find("::*)");
+    if (end == std::string::npos) {
+      return signature.find("(*)") != std::string::npos ? "função" : "outros";
+    }
+    std::string::size_type begin = signature.rfind('(', end);
+    return signature.substr(begin + 1, end - begin - 1);
+  }
+
+  void Finish()
+  {
+    EndCurrent();
+    m_finished = true;
+
+    struct Row
+    {
+      std::string owner;
+      std::string signature;
+      Stats stats;
+    };
+    std::vector<Row> rows;
+    for (const auto &entry : m_stats) {
+      std::string signature = Signature(Demangle(entry.first.name()));
+      std::replace(signature.begin(), signature.end(), ';', ',');
+      rows.push_back({Owner(signature), signature, entry.second});
+    }
+    std::sort(rows.begin(), rows.end(),
+              [](const Row &a, const Row &b) { return a.stats.totalNs > b.stats.totalNs; });
+
+    std::ofstream folded(m_outputFile);
+    folded << "Simulator::Run;Scheduler::RemoveNext " << m_removeNextNs / 1000 << "\n";
+    for (const Row &row : rows) {
+      std::string stack = "Simulator::Run;" + row.owner + ";" + row.signature;
+      folded << stack << " " << (row.stats.totalNs - row.stats.insertNs) / 1000 << "\n";
+      if (row.stats.insertNs > 0) {
+        folded << stack << ";Scheduler::Insert " << row.stats.insertNs / 1000 << "\n";
+      }
+    }
+
+    std::ofstream summary(m_outputFile + ".csv");
+    summary << "owner,signature,count,totalUs,meanNs,inserts,insertUs\n";
+    for (const Row &row : rows) {
+      summary << row.owner << ",\"" << row.signature << "\"," << row.stats.count << ","
+              << row.stats.totalNs / 1000 << "," << row.stats.totalNs / row.stats.count << ","
+              << row.stats.inserts << "," << row.stats.insertNs / 1000 << "\n";
+    }
+  }
+
+  Ptr<Scheduler> m_inner;
+  std::string m_outputFile;
+  std::unordered_map<std::type_index, Stats> m_stats;
+  mutable Stats *m_current;
+  Clock::time_point m_start;
+  uint64_t m_removeNextNs;
+  bool m_registered;
+  bool m_finished;
+};
+
+} // namespace ns3
+
+#endif // PROFILING_SCHEDULER_H
@@ -0,0 +1,143 @@
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include "wifi-star-scenario.h"
+#include "flow-summary.h"
+#include "sweep-runner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Uma replicação: índice e rodada do gerador aleatório (RngRun) usada por ela
+struct ReplicationPoint
+{
+  uint32_t index;
+  uint64_t run;
+
+  std::string Tag() const
+  {
+    return "r" + std::to_string(index);
+  }
+
+  static std::string CsvHeader()
+  {
+    return "replication,run";
+  }
+
+  std::string CsvColumns() const
+  {
+    return std::to_string(index) + "," + std::to_string(run);
+  }
+};
+
+// Configuração da replicação "index": as saídas ganham o sufixo "_r<index>"
+inline WifiStarConfig ReplicationConfig(const WifiStarConfig &base, uint32_t index)
+{
+  WifiStarConfig config = base;
+  config.AddOutputSuffix("_r" + std::to_string(index));
+  return config;
+}
+
+// Roda uma replicação no processo atual e grava as métricas dela (cabeçalho + uma linha) em "output"
+template <class Scenario>
+int RunReplication(const WifiStarConfig &config, const ReplicationPoint &point, const std::string &output)
+{
+  RngSeedManager::SetRun(point.run);
+  Scenario scenario(ReplicationConfig(config, point.index));
+  scenario.Build();
+  // Fluxos fixos a partir de 0: a rodada sozinha determina os números sorteados
+  scenario.AssignStreams(0);
+  scenario.Run();
+
+  FlowSummary s = SummarizeFlows(scenario.GetFlowRecorder());
+  FlowSummary tcp = SummarizeFlows(scenario.GetFlowRecorder(), 6, scenario.GetConfig().tcpPort);
+  std::ofstream out(output);
+  out << "simTimeS,flows,txPackets,rxPackets,txBytes,rxBytes,throughputMbps,meanDelayMs,pdr,jainIndex,"
+      << "tcpGoodputMbps,tcpDelayMs,tcpP95DelayMs\n";
+  out << Simulator::Now().GetSeconds() << "," << s.flows << "," << s.txPackets << "," << s.rxPackets << ","
+      << s.txBytes << "," << s.rxBytes << "," << s.throughputMbps << "," << s.meanDelayMs << "," << s.Pdr()
+      << "," << s.jainIndex << "," << scenario.GetGoodputMbps(TcpSocketFactory::GetTypeId()) << ","
+      << tcp.meanDelayMs << "," << tcp.p95DelayMs << "\n";
+  scenario.Teardown();
+  return out ? 0 : 1;
+}
+
+// Média, desvio padrão e meia-largura do IC de 95% de cada coluna numérica de um CSV com uma
+// linha por replicação (as colunas "skip" primeiras são identificadores e ficam de fora)
+inline void SummarizeReplications(const std::string &input, uint32_t skip, const std::string &output)
+{
+  std::ifstream in(input);
+  std::string line;
+  if (!std::getline(in, line)) {
+    return;
+  }
+  std::vector<std::string> names = SplitList(line);
+  std::vector<double> sum(names.size(), 0.0);
+  std::vector<double> sum2(names.size(), 0.0);
+  std::vector<double> min(names.size(), INFINITY);
+  std::vector<double> max(names.size(), -INFINITY);
+  uint32_t n = 0;
+  while (std::getline(in, line)) {
+    std::vector<std::string> values = SplitList(line);
+    for (size_t i = skip; i < values.size() && i < names.size(); i++) {
+      double x = std::stod(values[i]);
+      sum[i] += x;
+      sum2[i] += x * x;
+      min[i] = std::min(min[i], x);
+      max[i] = std::max(max[i], x);
+    }
+    n++;
+  }
+
+  std::ofstream out(output);
+  out << "metric,n,mean,stddev,ci95,min,max\n";
+  std::cout << "Métrica: média ± IC 95% (" << n << " replicações)" << std::endl;
+  for (size_t i = skip; i < names.size() && n > 0; i++) {
+    double mean = sum[i] / n;
+    double var = n > 1 ? std::max(0.0, (sum2[i] - n * mean * mean) / (n - 1)) : 0.0;
+    double half = n > 1 ? StudentT975(n - 1) * std::sqrt(var / n) : 0.0;
+    out << names[i] << "," << n << "," << mean << "," << std::sqrt(var) << "," << half << "," << min[i] << ","
+        << max[i] << "\n";
+    std::cout << "  " << names[i] << ": " << mean << " ± " << half << std::endl;
+  }
+}
+
+// Roda "replications" replicações independentes do mesmo ponto, em até "jobs" processos (0 = um
+// por núcleo). A replicação k usa RngRun = rodada atual + k e fluxos atribuídos por
+// Scenario::AssignStreams(); as métricas de cada uma vão para <output>_runs.csv e a média com
+// o intervalo de confiança de 95% de cada métrica para <output>_summary.csv.
+template <class Scenario>
+uint32_t RunReplications(const WifiStarConfig &config, uint32_t replications, uint32_t jobs,
+                         const std::string &output)
+{
+  uint64_t baseRun = RngSeedManager::GetRun();
+  std::vector<ReplicationPoint> points;
+  for (uint32_t k = 0; k < replications; k++) {
+    points.push_back({k, baseRun + k});
+  }
+
+  auto partName = [&output](const ReplicationPoint &point) { return output + "_" + point.Tag() + ".csv"; };
+  SweepRunner runner(jobs);
+  uint32_t failures = runner.Run(points, [&config, &partName](const ReplicationPoint &point) {
+    return RunReplication<Scenario>(config, point, partName(point));
+  });
+
+  MergeCsv(points, partName, output + "_runs.csv");
+  for (const ReplicationPoint &point : points) {
+    std::remove(partName(point).c_str());
+  }
+  SummarizeReplications(output + "_runs.csv", 2, output + "_summary.csv");
+  return failures;
+}
+
+} // namespace ns3
+
+#endif // REPLICATION_RUNNER_H
@@ -0,0 +1,137 @@
+#ifndef SCENARIO_BATCH_H
+#define SCENARIO_BATCH_H
+
+#include "replication-runner.h"
+#include "wifi-star-scenario.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Lê um arquivo de lote: cada linha é um ponto, escrito com as mesmas opções da linha de
+// comando (ex.: "--nSta=16 --dataRate=10Mbps --RngRun=3"). Linhas vazias ou iniciadas
+// por '#' são ignoradas.
+inline std::vector<std::vector<std::string>> ReadBatchFile(const std::string &fileName)
+{
+  std::vector<std::vector<std::string>> points;
+  std::ifstream in(fileName);
+  NS_ABORT_MSG_UNLESS(in, "Não foi possível abrir o arquivo de lote " << fileName);
+
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream words(line);
+    std::vector<std::string> args;
+    std::string word;
+    while (words >> word) {
+      args.push_back(word);
+    }
+    if (!args.empty() && args[0][0] != '#') {
+      points.push_back(args);
+    }
+  }
+  return points;
+}
+
+// Aplica as opções de um ponto sobre uma cópia da configuração base. As saídas da base recebem o
+// sufixo "_p<índice>" para não sobrescrever os outros pontos; as que o ponto escolher valem como estão.
+inline WifiStarConfig ApplyBatchPoint(const WifiStarConfig &base, const std::vector<std::string> &args,
+                                      uint32_t index)
+{
+  WifiStarConfig config = base;
+  config.AddOutputSuffix("_p" + std::to_string(index));
+  CommandLine cmd;
+  config.AddToCommandLine(cmd);
+  std::vector<std::string> argv = {"batch"};
+  argv.insert(argv.end(), args.begin(), args.end());
+  cmd.Parse(argv);
+  return config;
+}
+
+// main() comum dos cenários: lê os parâmetros da linha de comando e roda um único ponto ou,
+// com --batch=<arquivo>, todos os pontos do arquivo no mesmo processo, reaproveitando os helpers.
+// Com --replications=K cada ponto vira K replicações independentes em processos paralelos
+// (ver replication-runner.h), resumidas em <replicationOutput>[_p<índice>]_summary.csv. Com
+// --forkVariants=<arquivo> o aquecimento roda uma vez e cada linha do arquivo continua dele num
+// processo filho (WifiStarScenario::RunForked).
+template <class Scenario>
+int RunScenarioMain(WifiStarConfig config, int argc, char *argv[])
+{
+  std::string batch;
+  uint32_t replications = 1;
+  uint32_t jobs = 0;
+  std::string replicationOutput = "replications";
+  std::string forkVariants;
+  bool distributed = DistributedRun::Requested(argc, argv);
+  if (distributed) {
+    DistributedRun::Enable(&argc, &argv);
+  }
+
+  CommandLine cmd;
+  config.AddToCommandLine(cmd);
+  cmd.AddValue("batch", "Arquivo com um ponto (opções de linha de comando) por linha", batch);
+  cmd.AddValue("distributed", "Distribui servidor e células entre processos MPI (mpirun)", distributed);
+  cmd.AddValue("replications", "Replicações independentes de cada ponto (RngRun consecutivos)", replications);
+  cmd.AddValue("jobs", "Replicações ou variantes simultâneas (0 = uma por núcleo)", jobs);
+  cmd.AddValue("replicationOutput", "Prefixo dos CSV das replicações", replicationOutput);
+  cmd.AddValue("forkVariants", "Arquivo com variantes de tráfego que continuam do mesmo aquecimento", forkVariants);
+  cmd.Parse(argc, argv);
+  NS_ABORT_MSG_IF(replications > 1 && distributed, "--replications não pode ser combinado com --distributed");
+
+  // Aquecimento único até appStart e uma variante (mesmo formato do lote) por processo filho
+  if (!forkVariants.empty()) {
+    NS_ABORT_MSG_IF(replications > 1 || !batch.empty(), "--forkVariants não pode ser combinado com --batch ou --replications");
+    std::vector<WifiStarConfig> variants;
+    std::vector<std::vector<std::string>> points = ReadBatchFile(forkVariants);
+    for (uint32_t i = 0; i < points.size(); i++) {
+      for (const std::string &arg : points[i]) {
+        bool option = arg.compare(0, 2, "--") == 0;
+        NS_ABORT_MSG_UNLESS(option && WifiStarConfig::IsVariantOption(arg.substr(2, arg.find('=') - 2)),
+                            "Variante " << i << ": " << arg << " não pode mudar depois do aquecimento");
+      }
+      variants.push_back(ApplyBatchPoint(config, points[i], i));
+    }
+    Scenario scenario(config);
+    return scenario.RunForked(variants, jobs) == 0 ? 0 : 1;
+  }
+
+  if (replications > 1) {
+    uint32_t failures = 0;
+    if (batch.empty()) {
+      failures = RunReplications<Scenario>(config, replications, jobs, replicationOutput);
+    } else {
+      uint64_t baseRun = RngSeedManager::GetRun();
+      std::vector<std::vector<std::string>> points = ReadBatchFile(batch);
+      for (uint32_t i = 0; i < points.size(); i++) {
+        RngSeedManager::SetRun(baseRun);
+        failures += RunReplications<Scenario>(ApplyBatchPoint(config, points[i], i), replications, jobs,
+                                              replicationOutput + "_p" + std::to_string(i));
+      }
+    }
+    return failures == 0 ? 0 : 1;
+  }
+
+  Scenario scenario(config);
+  if (batch.empty()) {
+    scenario.Execute();
+    DistributedRun::Disable();
+    return 0;
+  }
+
+  // Um ponto que mude --RngRun não deve afetar os seguintes
+  uint64_t baseRun = RngSeedManager::GetRun();
+  std::vector<std::vector<std::string>> points = ReadBatchFile(batch);
+  for (uint32_t i = 0; i < points.size(); i++) {
+    RngSeedManager::SetRun(baseRun);
+    scenario.SetConfig(ApplyBatchPoint(config, points[i], i));
+    scenario.Execute();
+  }
+  DistributedRun::Disable();
+  return 0;
+}
+
+} // namespace ns3
+
+#endif // SCENARIO_BATCH_H
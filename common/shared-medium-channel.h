@@ -0,0 +1,276 @@
+#ifndef SHARED_MEDIUM_CHANNEL_H
+#define SHARED_MEDIUM_CHANNEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <cmath>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+// Meio compartilhado abstrato para estudos de transporte com muitos clientes: substitui o PHY e
+// o MAC do Wi-Fi por uma fila por transmissor e um único meio atendido em rodízio (um quadro por
+// transmissor com fila, como o DCF no longo prazo). O tempo de meio de cada quadro vem do modelo de
+// saturação do DCF de Bianchi, com n = transmissores com fila no início do quadro:
+//   tau = 2 / (W + 1 + p W sum_{k<m} (2p)^k),  p = 1 - (1 - tau)^(n - 1),
+// com W = CwMin + 1 e m = log2((CwMax + 1) / W) estágios de backoff exponencial, resolvido por
+// bisseção em p. Por slot, P_tr = 1 - (1 - tau)^n e P_s = n tau (1 - tau)^(n - 1) / P_tr, e cada
+// quadro entregue ocupa
+//   T_s / P_s + Slot (1 - P_tr) / (P_tr P_s),   T_s = FrameOverhead + bits / taxa do transmissor,
+// ou seja, o próprio quadro, as colisões (com a mesma duração do quadro) e os slots vazios por
+// sucesso. Com n = 1 o segundo termo é o backoff médio Slot * CwMin / 2; o total cresce devagar com
+// n (x1,2 a x1,7 de 4 a 50 transmissores e ~x5 com 1000, para 1024 bytes a 65 Mbps). Os dois
+// coeficientes são guardados por n. Não há erros de quadro nem retransmissões explícitas; o custo
+// por quadro é O(1) e os quadros unicast só são entregues ao destino. Usado com SimpleNetDevice
+// (SimpleNetDeviceHelper) no lugar do Wi-Fi.
+class SharedMediumChannel : public SimpleChannel
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid =
+        TypeId("ns3::SharedMediumChannel")
+            .SetParent<SimpleChannel>()
+            .SetGroupName("Network")
+            .AddConstructor<SharedMediumChannel>()
+            .AddAttribute("DataRate", "Taxa padrão dos transmissores",
+                          DataRateValue(DataRate("65Mbps")),
+                          MakeDataRateAccessor(&SharedMediumChannel::m_rate),
+                          MakeDataRateChecker())
+            .AddAttribute("FrameOverhead", "Tempo fixo por quadro (AIFS, preâmbulo, SIFS e ACK)",
+                          TimeValue(MicroSeconds(140)),
+                          MakeTimeAccessor(&SharedMediumChannel::m_overhead),
+                          MakeTimeChecker())
+            .AddAttribute("Slot", "Duração de um slot de backoff",
+                          TimeValue(MicroSeconds(9)),
+                          MakeTimeAccessor(&SharedMediumChannel::m_slot),
+                          MakeTimeChecker())
+            .AddAttribute("CwMin", "Janela de contenção mínima",
+                          UintegerValue(15),
+                          MakeUintegerAccessor(&SharedMediumChannel::m_cwMin),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("CwMax", "Janela de contenção máxima (define os estágios de backoff)",
+                          UintegerValue(1023),
+                          MakeUintegerAccessor(&SharedMediumChannel::m_cwMax),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("QueueLimit", "Quadros na fila de cada transmissor (descarta os excedentes)",
+                          UintegerValue(500),
+                          MakeUintegerAccessor(&SharedMediumChannel::m_queueLimit),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+  }
+
+  SharedMediumChannel()
+    : m_cwMin(15),
+      m_cwMax(1023),
+      m_queueLimit(500),
+      m_busy(false)
+  {
+  }
+
+  void Add(Ptr<SimpleNetDevice> device) override
+  {
+    SimpleChannel::Add(device);
+    m_index[PeekPointer(device)] = m_senders.size();
+    m_senders.push_back(Sender());
+    m_senders.back().device = device;
+    m_senders.back().rate = m_rate;
+    m_addresses.clear();
+  }
+
+  void Send(Ptr<Packet> p, uint16_t protocol, Mac48Address to, Mac48Address from,
+            Ptr<SimpleNetDevice> sender) override
+  {
+    Sender &s = m_senders[m_index[PeekPointer(sender)]];
+    if (s.queue.size() >= m_queueLimit) {
+      s.drops++;
+      return;
+    }
+    s.queue.push_back({p, protocol, to, from});
+    if (s.queue.size() == 1) {
+      m_backlogged.push_back(m_index[PeekPointer(sender)]);
+    }
+    if (!m_busy) {
+      StartNext();
+    }
+  }
+
+  // Taxa própria de um transmissor (ex.: clientes mais distantes com MCS menor)
+  void SetDataRate(Ptr<NetDevice> device, DataRate rate)
+  {
+    m_senders[m_index[PeekPointer(device)]].rate = rate;
+  }
+
+  // Tempo de meio ocupado pelos quadros do transmissor e quadros descartados na fila dele
+  Time GetAirtime(Ptr<NetDevice> device) const
+  {
+    return m_senders[m_index.at(PeekPointer(device))].airtime;
+  }
+
+  uint64_t GetDrops(Ptr<NetDevice> device) const
+  {
+    return m_senders[m_index.at(PeekPointer(device))].drops;
+  }
+
+  // Quadros esperando na fila do transmissor (sem o que está no meio)
+  uint32_t GetQueueLength(Ptr<NetDevice> device) const
+  {
+    return m_senders[m_index.at(PeekPointer(device))].queue.size();
+  }
+
+  // Meio livre e nenhuma fila com quadros
+  bool IsIdle() const
+  {
+    return !m_busy && m_backlogged.empty();
+  }
+
+private:
+  struct Frame
+  {
+    Ptr<Packet> packet;
+    uint16_t protocol;
+    Mac48Address to;
+    Mac48Address from;
+  };
+
+  struct Sender
+  {
+    Ptr<SimpleNetDevice> device;
+    DataRate rate;
+    std::deque<Frame> queue;
+    Time airtime;
+    uint64_t drops = 0;
+  };
+
+  // Coeficientes do modelo de Bianchi para n transmissores: 1 / P_s e slots vazios por sucesso
+  struct Contention
+  {
+    double frames = 0.0; // quadros (um entregue mais as colisões) por quadro entregue
+    double idle = 0.0;   // slots vazios por quadro entregue
+  };
+
+  // Probabilidade de transmissão num slot dada a probabilidade de colisão p
+  double Tau(double p) const
+  {
+    double w = m_cwMin + 1.0;
+    uint32_t stages = static_cast<uint32_t>(std::log2((m_cwMax + 1.0) / w) + 0.5);
+    double sum = 0.0;
+    double term = 1.0;
+    for (uint32_t k = 0; k < stages; k++) {
+      sum += term;
+      term *= 2 * p;
+    }
+    return 2.0 / (w + 1 + p * w * sum);
+  }
+
+  const Contention &GetContention(uint32_t n)
+  {
+    if (n >= m_contention.size()) {
+      m_contention.resize(n + 1);
+    }
+    Contention &c = m_contention[n];
+    if (c.frames > 0) {
+      return c;
+    }
+    // p - (1 - (1 - tau(p))^(n - 1)) é crescente em p: bisseção em [0, 1]
+    double low = 0.0;
+    double high = 1.0;
+    for (int i = 0; i < 60 && n > 1; i++) {
+      double middle = (low + high) / 2;
+      if (1 - std::pow(1 - Tau(middle), n - 1.0) > middle) {
+        low = middle;
+      } else {
+        high = middle;
+      }
+    }
+    double tau = Tau(n > 1 ? (low + high) / 2 : 0.0);
+    double transmit = 1 - std::pow(1 - tau, static_cast<double>(n));
+    double success = n * tau * std::pow(1 - tau, n - 1.0) / transmit;
+    c.frames = 1 / success;
+    c.idle = (1 - transmit) / (transmit * success);
+    return c;
+  }
+
+  // Tempo de meio de um quadro com n transmissores disputando o acesso
+  Time Airtime(const Sender &s, uint32_t bytes, uint32_t n)
+  {
+    const Contention &c = GetContention(n);
+    Time frame = m_overhead + s.rate.CalculateBytesTxTime(bytes);
+    return frame * c.frames + m_slot * c.idle;
+  }
+
+  void StartNext()
+  {
+    uint32_t n = m_backlogged.size();
+    uint32_t i = m_backlogged.front();
+    m_backlogged.pop_front();
+    Sender &s = m_senders[i];
+    Frame frame = s.queue.front();
+    s.queue.pop_front();
+
+    Time airtime = Airtime(s, frame.packet->GetSize(), n);
+    s.airtime += airtime;
+    m_busy = true;
+    Simulator::Schedule(airtime, &SharedMediumChannel::EndTx, this, i, frame);
+  }
+
+  void EndTx(uint32_t i, Frame frame)
+  {
+    Deliver(m_senders[i].device, frame);
+    if (!m_senders[i].queue.empty()) {
+      m_backlogged.push_back(i);
+    }
+    m_busy = false;
+    if (!m_backlogged.empty()) {
+      StartNext();
+    }
+  }
+
+  void Deliver(Ptr<SimpleNetDevice> sender, const Frame &frame)
+  {
+    if (frame.to.IsBroadcast() || frame.to.IsGroup()) {
+      for (const Sender &s : m_senders) {
+        if (s.device != sender) {
+          DeliverTo(s.device, frame);
+        }
+      }
+      return;
+    }
+    if (m_addresses.empty()) {
+      for (const Sender &s : m_senders) {
+        m_addresses[Mac48Address::ConvertFrom(s.device->GetAddress())] = s.device;
+      }
+    }
+    auto it = m_addresses.find(frame.to);
+    if (it != m_addresses.end()) {
+      DeliverTo(it->second, frame);
+    }
+  }
+
+  void DeliverTo(Ptr<SimpleNetDevice> device, const Frame &frame)
+  {
+    Simulator::ScheduleWithContext(device->GetNode()->GetId(), Seconds(0), &SimpleNetDevice::Receive, device,
+                                   frame.packet->Copy(), frame.protocol, frame.to, frame.from);
+  }
+
+  DataRate m_rate;
+  Time m_overhead;
+  Time m_slot;
+  uint32_t m_cwMin;
+  uint32_t m_cwMax;
+  uint32_t m_queueLimit;
+  std::vector<Contention> m_contention; // por número de transmissores com fila
+
+  std::vector<Sender> m_senders;
+  std::map<const NetDevice *, uint32_t> m_index;
+  std::map<Mac48Address, Ptr<SimpleNetDevice>> m_addresses; // montado no primeiro unicast
+  std::deque<uint32_t> m_backlogged; // transmissores com fila, em ordem de atendimento
+  bool m_busy;
+};
+
+} // namespace ns3
+
+#endif // SHARED_MEDIUM_CHANNEL_H
@@ -0,0 +1,72 @@
+#ifndef STAR_ROUTING_H
+#define STAR_ROUTING_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+namespace ns3 {
+
+// Rotas estáticas da topologia em estrela (clientes - AP - servidor), no lugar do
+// Ipv4GlobalRoutingHelper::PopulateRoutingTables(), que roda um SPF sobre todos os nós e instala
+// rotas de host em cada cliente. Aqui cada cliente recebe só uma rota padrão pelo AP da sua célula
+// e o servidor uma rota por célula para a sub-rede Wi-Fi, pelo AP; o AP já tem as rotas das duas
+// redes a que está ligado (rotas de interface do Ipv4StaticRouting). O custo é O(1) por cliente e
+// por célula, e um nó que entra depois só precisa da própria rota: AddStation() para um cliente
+// novo numa célula existente, AddCell() mais AddStation() para uma célula nova; nenhuma outra
+// rota é recalculada.
+class StarRouting
+{
+public:
+  // Rota padrão do cliente pelo endereço Wi-Fi do AP
+  static void AddStation(Ptr<NetDevice> staDevice, Ipv4Address apAddress)
+  {
+    Ptr<Ipv4> ipv4 = staDevice->GetNode()->GetObject<Ipv4>();
+    GetStaticRouting(ipv4)->SetDefaultRoute(apAddress, ipv4->GetInterfaceForDevice(staDevice));
+  }
+
+  // Rota do servidor para a sub-rede Wi-Fi de uma célula, pelo endereço P2P do AP
+  static void AddCell(Ptr<NetDevice> serverDevice, Ipv4Address apP2pAddress, Ipv4Address wifiNetwork,
+                      Ipv4Mask wifiMask)
+  {
+    Ptr<Ipv4> ipv4 = serverDevice->GetNode()->GetObject<Ipv4>();
+    GetStaticRouting(ipv4)->AddNetworkRouteTo(wifiNetwork, wifiMask, apP2pAddress,
+                                              ipv4->GetInterfaceForDevice(serverDevice));
+  }
+
+  // As mesmas rotas em IPv6 (endereços globais do AP)
+  static void AddStation(Ptr<NetDevice> staDevice, Ipv6Address apAddress)
+  {
+    Ptr<Ipv6> ipv6 = staDevice->GetNode()->GetObject<Ipv6>();
+    GetStaticRouting(ipv6)->SetDefaultRoute(apAddress, ipv6->GetInterfaceForDevice(staDevice));
+  }
+
+  static void AddCell(Ptr<NetDevice> serverDevice, Ipv6Address apP2pAddress, Ipv6Address wifiNetwork,
+                      Ipv6Prefix wifiPrefix)
+  {
+    Ptr<Ipv6> ipv6 = serverDevice->GetNode()->GetObject<Ipv6>();
+    GetStaticRouting(ipv6)->AddNetworkRouteTo(wifiNetwork, wifiPrefix, apP2pAddress,
+                                              ipv6->GetInterfaceForDevice(serverDevice));
+  }
+
+private:
+  static Ptr<Ipv4StaticRouting> GetStaticRouting(Ptr<Ipv4> ipv4)
+  {
+    Ipv4StaticRoutingHelper helper;
+    Ptr<Ipv4StaticRouting> routing = helper.GetStaticRouting(ipv4);
+    NS_ABORT_MSG_UNLESS(routing, "O nó não tem Ipv4StaticRouting na lista de roteamento");
+    return routing;
+  }
+
+  static Ptr<Ipv6StaticRouting> GetStaticRouting(Ptr<Ipv6> ipv6)
+  {
+    Ipv6StaticRoutingHelper helper;
+    Ptr<Ipv6StaticRouting> routing = helper.GetStaticRouting(ipv6);
+    NS_ABORT_MSG_UNLESS(routing, "O nó não tem Ipv6StaticRouting na lista de roteamento");
+    return routing;
+  }
+};
+
+} // namespace ns3
+
+#endif // STAR_ROUTING_H
@@ -0,0 +1,167 @@
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Um ponto da varredura: número de clientes, rodada do gerador aleatório e transporte
+struct SweepPoint
+{
+  uint32_t numClients;
+  uint32_t run;
+  std::string transport;
+
+  // Identificador usado no nome dos arquivos de saída do ponto
+  std::string Tag() const
+  {
+    return transport + "_n" + std::to_string(numClients) + "_r" + std::to_string(run);
+  }
+
+  static std::string CsvHeader()
+  {
+    return "numClients,run,transport";
+  }
+
+  std::string CsvColumns() const
+  {
+    return std::to_string(numClients) + "," + std::to_string(run) + "," + transport;
+  }
+};
+
+// Divide uma lista do tipo "4,8,16,32" nos seus elementos
+inline std::vector<std::string> SplitList(const std::string &list, char sep = ',')
+{
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, sep)) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+// Executa cada ponto em um processo filho (fork), com no máximo "jobs" filhos ao mesmo
+// tempo. O processo pai não toca no Simulator, então cada filho começa de um estado limpo.
+class SweepRunner
+{
+public:
+  explicit SweepRunner(uint32_t jobs = 0)
+    : m_jobs(jobs)
+  {
+    if (m_jobs == 0) {
+      long cores = sysconf(_SC_NPROCESSORS_ONLN);
+      m_jobs = cores > 0 ? static_cast<uint32_t>(cores) : 1;
+    }
+  }
+
+  uint32_t GetJobs() const
+  {
+    return m_jobs;
+  }
+
+  // worker(ponto) roda no filho e devolve o código de saída. Retorna o número de pontos que falharam.
+  template <class Point, class Worker>
+  uint32_t Run(const std::vector<Point> &points, Worker worker) const
+  {
+    std::map<pid_t, size_t> running;
+    uint32_t failures = 0;
+    size_t next = 0;
+
+    // Evita que os buffers do pai sejam duplicados nos filhos
+    std::cout.flush();
+    std::cerr.flush();
+
+    while (next < points.size() || !running.empty()) {
+      while (next < points.size() && running.size() < m_jobs) {
+        pid_t pid = fork();
+        if (pid < 0) {
+          std::perror("fork");
+          break;
+        }
+        if (pid == 0) {
+          int status = worker(points[next]);
+          std::cout.flush();
+          std::cerr.flush();
+          _exit(status);
+        }
+        running[pid] = next++;
+      }
+
+      if (running.empty()) {
+        // fork falhou sem nenhum filho em execução: não há como progredir
+        failures += points.size() - next;
+        break;
+      }
+
+      int status = 0;
+      pid_t pid = waitpid(-1, &status, 0);
+      if (pid < 0) {
+        std::perror("waitpid");
+        break;
+      }
+      auto it = running.find(pid);
+      if (it == running.end()) {
+        continue;
+      }
+      if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        failures++;
+        std::cerr << "Ponto " << it->second << " falhou (status " << status << ")" << std::endl;
+      }
+      running.erase(it);
+    }
+    return failures;
+  }
+
+private:
+  uint32_t m_jobs;
+};
+
+// Apaga a saída de cada ponto antes da varredura, para que um ponto que falhe agora não deixe no
+// resultado final o CSV de uma execução anterior
+template <class Point, class PartName>
+void RemoveParts(const std::vector<Point> &points, PartName partName)
+{
+  for (const Point &point : points) {
+    std::remove(partName(point).c_str());
+  }
+}
+
+// Junta os CSV gerados por cada ponto em um único arquivo, na ordem dos pontos,
+// acrescentando as colunas que identificam o ponto. Pontos sem saída são ignorados.
+template <class Point, class PartName>
+void MergeCsv(const std::vector<Point> &points, PartName partName, const std::string &output)
+{
+  std::ofstream out(output);
+  bool headerWritten = false;
+  for (const Point &point : points) {
+    std::ifstream in(partName(point));
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+      continue;
+    }
+    if (!headerWritten) {
+      out << Point::CsvHeader() << "," << line << "\n";
+      headerWritten = true;
+    }
+    while (std::getline(in, line)) {
+      out << point.CsvColumns() << "," << line << "\n";
+    }
+  }
+}
+
+} // namespace ns3
+
+#endif // SWEEP_RUNNER_H
@@ -0,0 +1,312 @@
+#ifndef TRAJECTORY_MOBILITY_H
+#define TRAJECTORY_MOBILITY_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace ns3 {
+
+// Tabela de trajetórias: a posição de cada nó é uma função fechada do tempo, p(t) = p0 + v (t - t0),
+// guardada como estrutura de vetores (um vetor por campo). Consultar posição ou distância não
+// precisa de estado por nó nem de chamadas virtuais, e a consulta em lote (um nó contra todos)
+// devolve distâncias ao quadrado: só multiplicação e soma sobre vetores contíguos, sem desvios nem
+// raiz quadrada, escritas com os vetores nativos do GCC/Clang (4 doubles por operação, AVX ou dois
+// registradores SSE2), então a consulta é vetorizada em qualquer perfil de compilação do ns-3, sem
+// depender do vetorizador automático nem de -fopenmp-simd.
+class TrajectoryTable : public Object
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::TrajectoryTable").SetParent<Object>().SetGroupName("Mobility");
+    return tid;
+  }
+
+  // Tabela compartilhada pelos nós da rodada (esvaziada em Clear())
+  static Ptr<TrajectoryTable> Get()
+  {
+    static Ptr<TrajectoryTable> table = CreateObject<TrajectoryTable>();
+    return table;
+  }
+
+  TrajectoryTable()
+    : m_version(0)
+  {
+  }
+
+  uint32_t AddLinear(const Vector &position, const Vector &velocity, double t0)
+  {
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_z.push_back(position.z);
+    m_vx.push_back(velocity.x);
+    m_vy.push_back(velocity.y);
+    m_vz.push_back(velocity.z);
+    m_t0.push_back(t0);
+    m_version++;
+    return m_x.size() - 1;
+  }
+
+  // Nova trajetória linear a partir de t (usada por SetPosition() e SetVelocity())
+  void Rebase(uint32_t i, const Vector &position, const Vector &velocity, double t)
+  {
+    m_x[i] = position.x;
+    m_y[i] = position.y;
+    m_z[i] = position.z;
+    m_vx[i] = velocity.x;
+    m_vy[i] = velocity.y;
+    m_vz[i] = velocity.z;
+    m_t0[i] = t;
+    m_version++;
+  }
+
+  Vector Position(uint32_t i, double t) const
+  {
+    double dt = t - m_t0[i];
+    return Vector(m_x[i] + m_vx[i] * dt, m_y[i] + m_vy[i] * dt, m_z[i] + m_vz[i] * dt);
+  }
+
+  Vector Velocity(uint32_t i) const
+  {
+    return Vector(m_vx[i], m_vy[i], m_vz[i]);
+  }
+
+  double Distance(uint32_t a, uint32_t b, double t) const
+  {
+    Vector pa = Position(a, t);
+    Vector pb = Position(b, t);
+    double dx = pa.x - pb.x;
+    double dy = pa.y - pb.y;
+    double dz = pa.z - pb.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+
+  // Distância ao quadrado do nó "from" a todos os nós no instante t (out precisa de GetN() posições)
+  void SquaredDistancesFrom(uint32_t from, double t, double *out) const
+  {
+    Vector p = Position(from, t);
+    uint32_t n = GetN();
+    const double *x = m_x.data();
+    const double *y = m_y.data();
+    const double *z = m_z.data();
+    const double *vx = m_vx.data();
+    const double *vy = m_vy.data();
+    const double *vz = m_vz.data();
+    const double *t0 = m_t0.data();
+    uint32_t j = 0;
+    for (; j + LANES <= n; j += LANES) {
+      Lanes lx, ly, lz, lvx, lvy, lvz, lt0;
+      Load(lx, x + j);
+      Load(ly, y + j);
+      Load(lz, z + j);
+      Load(lvx, vx + j);
+      Load(lvy, vy + j);
+      Load(lvz, vz + j);
+      Load(lt0, t0 + j);
+      Lanes dt = t - lt0;
+      Lanes dx = lx + lvx * dt - p.x;
+      Lanes dy = ly + lvy * dt - p.y;
+      Lanes dz = lz + lvz * dt - p.z;
+      Lanes d2 = dx * dx + dy * dy + dz * dz;
+      std::memcpy(out + j, &d2, sizeof(d2));
+    }
+    for (; j < n; j++) {
+      double dt = t - t0[j];
+      double dx = x[j] + vx[j] * dt - p.x;
+      double dy = y[j] + vy[j] * dt - p.y;
+      double dz = z[j] + vz[j] * dt - p.z;
+      out[j] = dx * dx + dy * dy + dz * dz;
+    }
+  }
+
+  uint32_t GetN() const
+  {
+    return m_x.size();
+  }
+
+  // Muda sempre que alguma trajetória muda; serve para invalidar resultados guardados
+  uint64_t GetVersion() const
+  {
+    return m_version;
+  }
+
+  void Clear()
+  {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_vz.clear();
+    m_t0.clear();
+    m_version++;
+  }
+
+private:
+  static const uint32_t LANES = 4;
+  typedef double Lanes __attribute__((vector_size(LANES * sizeof(double))));
+
+  // Leitura sem exigir alinhamento (os vetores da tabela só garantem o de double). O vetor sai por
+  // referência: devolvê-lo por valor muda a ABI conforme o -mavx e o GCC avisa (-Wpsabi)
+  static void Load(Lanes &v, const double *p)
+  {
+    std::memcpy(&v, p, sizeof(v));
+  }
+
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_z;
+  std::vector<double> m_vx;
+  std::vector<double> m_vy;
+  std::vector<double> m_vz;
+  std::vector<double> m_t0;
+  uint64_t m_version;
+};
+
+// MobilityModel que só guarda o índice do nó na TrajectoryTable
+class TrajectoryMobilityModel : public MobilityModel
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::TrajectoryMobilityModel")
+                            .SetParent<MobilityModel>()
+                            .SetGroupName("Mobility")
+                            .AddConstructor<TrajectoryMobilityModel>();
+    return tid;
+  }
+
+  TrajectoryMobilityModel()
+    : m_table(TrajectoryTable::Get()),
+      m_index(m_table->AddLinear(Vector(0.0, 0.0, 0.0), Vector(0.0, 0.0, 0.0), 0.0))
+  {
+  }
+
+  Ptr<TrajectoryTable> GetTable() const
+  {
+    return m_table;
+  }
+
+  uint32_t GetIndex() const
+  {
+    return m_index;
+  }
+
+  void SetVelocity(const Vector &velocity)
+  {
+    double now = Simulator::Now().GetSeconds();
+    m_table->Rebase(m_index, m_table->Position(m_index, now), velocity, now);
+    NotifyCourseChange();
+  }
+
+private:
+  Vector DoGetPosition() const override
+  {
+    return m_table->Position(m_index, Simulator::Now().GetSeconds());
+  }
+
+  void DoSetPosition(const Vector &position) override
+  {
+    double now = Simulator::Now().GetSeconds();
+    m_table->Rebase(m_index, position, m_table->Velocity(m_index), now);
+    NotifyCourseChange();
+  }
+
+  Vector DoGetVelocity() const override
+  {
+    return m_table->Velocity(m_index);
+  }
+
+  Ptr<TrajectoryTable> m_table;
+  uint32_t m_index;
+};
+
+// Mesma perda do LogDistancePropagationLossModel padrão (expoente 3, 46,6777 dB a 1 m), mas com a
+// distância tirada da TrajectoryTable quando os dois nós estão nela. Os canais calculam a perda
+// de um transmissor para todos os receptores no mesmo instante, então a primeira consulta de um
+// transmissor calcula a linha inteira em lote e as seguintes só leem o resultado. A linha sai das
+// distâncias ao quadrado, 10 n log10(d) = 5 n log10(d²), sem raiz quadrada e sem desvio (abaixo da
+// distância de referência o log é zero). O log10 continua sendo uma chamada da libm por receptor.
+class TrajectoryLogDistanceLossModel : public PropagationLossModel
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::TrajectoryLogDistanceLossModel")
+                            .SetParent<PropagationLossModel>()
+                            .SetGroupName("Propagation")
+                            .AddConstructor<TrajectoryLogDistanceLossModel>();
+    return tid;
+  }
+
+  TrajectoryLogDistanceLossModel()
+    : m_exponent(3.0),
+      m_referenceDistance(1.0),
+      m_referenceLoss(46.6777),
+      m_rowFrom(UINT32_MAX),
+      m_rowVersion(0)
+  {
+  }
+
+private:
+  double DoCalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override
+  {
+    const TrajectoryMobilityModel *ta = dynamic_cast<const TrajectoryMobilityModel *>(PeekPointer(a));
+    const TrajectoryMobilityModel *tb = dynamic_cast<const TrajectoryMobilityModel *>(PeekPointer(b));
+    if (!ta || !tb || ta->GetTable() != tb->GetTable()) {
+      return txPowerDbm - Loss(a->GetDistanceFrom(b));
+    }
+
+    Ptr<TrajectoryTable> table = ta->GetTable();
+    Time now = Simulator::Now();
+    if (m_rowFrom != ta->GetIndex() || m_rowTime != now || m_rowVersion != table->GetVersion()) {
+      m_rowFrom = ta->GetIndex();
+      m_rowTime = now;
+      m_rowVersion = table->GetVersion();
+      m_row.resize(table->GetN());
+      table->SquaredDistancesFrom(m_rowFrom, now.GetSeconds(), m_row.data());
+      double *row = m_row.data();
+      uint32_t n = m_row.size();
+      double reference2 = m_referenceDistance * m_referenceDistance;
+      double factor = 5 * m_exponent;
+      for (uint32_t j = 0; j < n; j++) {
+        row[j] = m_referenceLoss + factor * std::log10(std::max(row[j], reference2) / reference2);
+      }
+    }
+    return txPowerDbm - m_row[tb->GetIndex()];
+  }
+
+  int64_t DoAssignStreams(int64_t stream) override
+  {
+    return 0;
+  }
+
+  double Loss(double distance) const
+  {
+    if (distance <= m_referenceDistance) {
+      return m_referenceLoss;
+    }
+    return m_referenceLoss + 10 * m_exponent * std::log10(distance / m_referenceDistance);
+  }
+
+  double m_exponent;
+  double m_referenceDistance;
+  double m_referenceLoss;
+
+  // Perdas (dB) do último transmissor para todos os nós
+  mutable uint32_t m_rowFrom;
+  mutable Time m_rowTime;
+  mutable uint64_t m_rowVersion;
+  mutable std::vector<double> m_row;
+};
+
+} // namespace ns3
+
+#endif // TRAJECTORY_MOBILITY_H
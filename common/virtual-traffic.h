@@ -0,0 +1,343 @@
+#ifndef VIRTUAL_TRAFFIC_H
+#define VIRTUAL_TRAFFIC_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+namespace ns3 {
+
+// Fonte de tráfego só com bytes virtuais: cada pacote é um Create<Packet>(n), cuja carga fica como
+// área de zeros virtual no Buffer do ns-3 e nunca é escrita nem copiada (os cabeçalhos das camadas
+// de baixo continuam reais). Não há SeqTsSizeHeader, variáveis aleatórias nem os traces por pacote
+// (que consultam o endereço do socket a cada envio), só a lógica de envio:
+//  - DataRate > 0: a mesma sequência de envios do OnOffApplication com OnTime = 1 e OffTime = 0
+//    (ciclos de 1 s com os bits residuais e o pacote recusado pelo socket guardado para o ciclo
+//    seguinte), para que o FlowMonitor conte os mesmos pacotes e bytes;
+//  - DataRate = 0: a mesma sequência do BulkSendApplication (PacketSize faz o papel de SendSize).
+class VirtualSource : public Application
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid =
+        TypeId("ns3::VirtualSource")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<VirtualSource>()
+            .AddAttribute("Remote", "Endereço do destino", AddressValue(),
+                          MakeAddressAccessor(&VirtualSource::m_peer), MakeAddressChecker())
+            .AddAttribute("Protocol", "Fábrica de sockets (UDP ou TCP)",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&VirtualSource::m_tid), MakeTypeIdChecker())
+            .AddAttribute("DataRate", "Taxa constante; 0 envia o mais rápido possível (BulkSend)",
+                          DataRateValue(DataRate(0)),
+                          MakeDataRateAccessor(&VirtualSource::m_rate), MakeDataRateChecker())
+            .AddAttribute("PacketSize", "Bytes virtuais por pacote (ou por envio, sem DataRate)",
+                          UintegerValue(512),
+                          MakeUintegerAccessor(&VirtualSource::m_pktSize), MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxBytes", "Total de bytes a enviar; 0 = ilimitado",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&VirtualSource::m_maxBytes), MakeUintegerChecker<uint64_t>());
+    return tid;
+  }
+
+  VirtualSource()
+    : m_pktSize(512),
+      m_maxBytes(0),
+      m_totBytes(0),
+      m_residualBits(0),
+      m_connected(false)
+  {
+  }
+
+  uint64_t GetTotalTx() const
+  {
+    return m_totBytes;
+  }
+
+private:
+  void StartApplication() override
+  {
+    if (!m_socket) {
+      m_socket = Socket::CreateSocket(GetNode(), m_tid);
+      int ret = Inet6SocketAddress::IsMatchingType(m_peer) ? m_socket->Bind6() : m_socket->Bind();
+      NS_ABORT_MSG_IF(ret == -1, "Não foi possível associar o socket da fonte virtual");
+      m_socket->SetConnectCallback(MakeCallback(&VirtualSource::ConnectionSucceeded, this),
+                                   MakeCallback(&VirtualSource::ConnectionFailed, this));
+      if (IsBulk()) {
+        m_socket->SetSendCallback(MakeCallback(&VirtualSource::DataSend, this));
+      }
+      m_socket->Connect(m_peer);
+      m_socket->ShutdownRecv();
+    }
+    if (IsBulk()) {
+      if (m_connected) {
+        SendData();
+      }
+      return;
+    }
+    CancelEvents();
+    // Sem conexão ainda, ConnectionSucceeded() inicia o ciclo
+    if (m_connected) {
+      m_cycleEvent = Simulator::ScheduleNow(&VirtualSource::StartSending, this);
+    }
+  }
+
+  void StopApplication() override
+  {
+    CancelEvents();
+    if (m_socket) {
+      m_socket->Close();
+    }
+    m_connected = false;
+  }
+
+  bool IsBulk() const
+  {
+    return m_rate.GetBitRate() == 0;
+  }
+
+  void ConnectionSucceeded(Ptr<Socket> socket)
+  {
+    m_connected = true;
+    if (IsBulk()) {
+      SendData();
+    } else {
+      m_cycleEvent = Simulator::ScheduleNow(&VirtualSource::StartSending, this);
+    }
+  }
+
+  void ConnectionFailed(Ptr<Socket> socket)
+  {
+    NS_FATAL_ERROR("Falha na conexão da fonte virtual");
+  }
+
+  // ---- Taxa constante (OnOff sempre ligado) ----
+
+  void CancelEvents()
+  {
+    if (m_sendEvent.IsRunning()) {
+      // Bits já "transmitidos" desde o último pacote, descontados do próximo intervalo
+      Time delta = Simulator::Now() - m_lastStartTime;
+      int64x64_t bits = delta.To(Time::S) * m_rate.GetBitRate();
+      m_residualBits += bits.GetHigh();
+    }
+    m_sendEvent.Cancel();
+    m_cycleEvent.Cancel();
+    m_unsentPacket = nullptr;
+  }
+
+  void StartSending()
+  {
+    m_lastStartTime = Simulator::Now();
+    ScheduleNextTx();
+    m_cycleEvent = Simulator::Schedule(Seconds(1.0), &VirtualSource::StopSending, this);
+  }
+
+  void StopSending()
+  {
+    CancelEvents();
+    m_cycleEvent = Simulator::ScheduleNow(&VirtualSource::StartSending, this);
+  }
+
+  void ScheduleNextTx()
+  {
+    if (m_maxBytes == 0 || m_totBytes < m_maxBytes) {
+      uint32_t bits = m_pktSize * 8 - m_residualBits;
+      m_sendEvent = Simulator::Schedule(Seconds(bits / static_cast<double>(m_rate.GetBitRate())),
+                                        &VirtualSource::SendPacket, this);
+    } else {
+      StopApplication();
+    }
+  }
+
+  void SendPacket()
+  {
+    Ptr<Packet> packet = m_unsentPacket ? m_unsentPacket : Create<Packet>(m_pktSize);
+    if (static_cast<uint32_t>(m_socket->Send(packet)) == m_pktSize) {
+      m_totBytes += m_pktSize;
+      m_unsentPacket = nullptr;
+      m_residualBits = 0;
+      m_lastStartTime = Simulator::Now();
+      ScheduleNextTx();
+    } else {
+      // Como no OnOff: o pacote espera o próximo ciclo
+      m_unsentPacket = packet;
+    }
+  }
+
+  // ---- O mais rápido possível (BulkSend) ----
+
+  void DataSend(Ptr<Socket> socket, uint32_t available)
+  {
+    if (m_connected) {
+      SendData();
+    }
+  }
+
+  void SendData()
+  {
+    while (m_maxBytes == 0 || m_totBytes < m_maxBytes) {
+      uint64_t toSend = m_pktSize;
+      if (m_maxBytes > 0) {
+        toSend = std::min<uint64_t>(toSend, m_maxBytes - m_totBytes);
+      }
+      Ptr<Packet> packet;
+      if (m_unsentPacket) {
+        packet = m_unsentPacket;
+        toSend = packet->GetSize();
+      } else {
+        packet = Create<Packet>(toSend);
+      }
+      int actual = m_socket->Send(packet);
+      if (actual > 0 && static_cast<uint64_t>(actual) == toSend) {
+        m_totBytes += actual;
+        m_unsentPacket = nullptr;
+      } else if (actual > 0) {
+        m_totBytes += actual;
+        m_unsentPacket = packet->CreateFragment(actual, toSend - actual);
+        break;
+      } else {
+        m_unsentPacket = packet;
+        break;
+      }
+    }
+    if (m_maxBytes > 0 && m_totBytes == m_maxBytes && m_connected) {
+      m_socket->Close();
+      m_connected = false;
+    }
+  }
+
+  Address m_peer;
+  TypeId m_tid;
+  DataRate m_rate;
+  uint32_t m_pktSize;
+  uint64_t m_maxBytes;
+  Ptr<Socket> m_socket;
+  uint64_t m_totBytes;
+  uint32_t m_residualBits;
+  Time m_lastStartTime;
+  Ptr<Packet> m_unsentPacket;
+  bool m_connected;
+  EventId m_sendEvent;
+  EventId m_cycleEvent;
+};
+
+// Sorvedouro que só conta os bytes recebidos (mesmos sockets e chamadas do PacketSink, sem os
+// traces por pacote)
+class VirtualSink : public Application
+{
+public:
+  static TypeId GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::VirtualSink")
+                            .SetParent<Application>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<VirtualSink>()
+                            .AddAttribute("Local", "Endereço de escuta", AddressValue(),
+                                          MakeAddressAccessor(&VirtualSink::m_local), MakeAddressChecker())
+                            .AddAttribute("Protocol", "Fábrica de sockets (UDP ou TCP)",
+                                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                                          MakeTypeIdAccessor(&VirtualSink::m_tid), MakeTypeIdChecker());
+    return tid;
+  }
+
+  VirtualSink()
+    : m_totalRx(0)
+  {
+  }
+
+  uint64_t GetTotalRx() const
+  {
+    return m_totalRx;
+  }
+
+private:
+  void StartApplication() override
+  {
+    if (!m_socket) {
+      m_socket = Socket::CreateSocket(GetNode(), m_tid);
+      NS_ABORT_MSG_IF(m_socket->Bind(m_local) == -1, "Não foi possível associar o socket do sorvedouro virtual");
+      m_socket->Listen();
+      m_socket->ShutdownSend();
+    }
+    m_socket->SetRecvCallback(MakeCallback(&VirtualSink::HandleRead, this));
+    m_socket->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address &>(),
+                                MakeCallback(&VirtualSink::HandleAccept, this));
+  }
+
+  void StopApplication() override
+  {
+    for (Ptr<Socket> socket : m_accepted) {
+      socket->Close();
+    }
+    m_accepted.clear();
+    if (m_socket) {
+      m_socket->Close();
+      m_socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+    }
+  }
+
+  void HandleRead(Ptr<Socket> socket)
+  {
+    while (Ptr<Packet> packet = socket->Recv()) {
+      if (packet->GetSize() == 0) {
+        break;
+      }
+      m_totalRx += packet->GetSize();
+    }
+  }
+
+  void HandleAccept(Ptr<Socket> socket, const Address &from)
+  {
+    socket->SetRecvCallback(MakeCallback(&VirtualSink::HandleRead, this));
+    m_accepted.push_back(socket);
+  }
+
+  Address m_local;
+  TypeId m_tid;
+  Ptr<Socket> m_socket;
+  std::list<Ptr<Socket>> m_accepted;
+  uint64_t m_totalRx;
+};
+
+// Instala VirtualSource/VirtualSink como os helpers do ns-3 (um aplicativo por nó)
+class VirtualTrafficHelper
+{
+public:
+  VirtualTrafficHelper(const TypeId &type, const std::string &protocol, const std::string &addressAttribute,
+                       const Address &address)
+  {
+    m_factory.SetTypeId(type);
+    m_factory.Set("Protocol", StringValue(protocol));
+    m_factory.Set(addressAttribute, AddressValue(address));
+  }
+
+  void SetAttribute(const std::string &name, const AttributeValue &value)
+  {
+    m_factory.Set(name, value);
+  }
+
+  ApplicationContainer Install(NodeContainer nodes) const
+  {
+    ApplicationContainer apps;
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      Ptr<Application> app = m_factory.Create<Application>();
+      nodes.Get(i)->AddApplication(app);
+      apps.Add(app);
+    }
+    return apps;
+  }
+
+private:
+  ObjectFactory m_factory;
+};
+
+} // namespace ns3
+
+#endif // VIRTUAL_TRAFFIC_H
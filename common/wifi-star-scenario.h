@@ -0,0 +1,1357 @@
+#ifndef WIFI_STAR_SCENARIO_H
+#define WIFI_STAR_SCENARIO_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/netanim-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include "address-plan.h"
+#include "airtime-fair-queue-disc.h"
+#include "ap-telemetry.h"
+#include "cached-loss-model.h"
+#include "compact-flow-monitor.h"
+#include "convergence-monitor.h"
+#include "flow-recorder.h"
+#include "flow-stats-sampler.h"
+#include "flow-summary.h"
+#include "grid-spectrum-channel.h"
+#include "ladder-scheduler.h"
+#include "mpi-support.h"
+#include "pcap-tracer.h"
+#include "profiling-scheduler.h"
+#include "shared-medium-channel.h"
+#include "star-routing.h"
+#include "sweep-runner.h"
+#include "trajectory-mobility.h"
+#include "virtual-traffic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+// Acrescenta um sufixo ao nome do arquivo, antes da extensão ("a.xml" -> "a_p2.xml")
+inline std::string WithSuffix(const std::string &fileName, const std::string &suffix)
+{
+  std::string::size_type dot = fileName.rfind('.');
+  if (dot == std::string::npos) {
+    return fileName + suffix;
+  }
+  return fileName.substr(0, dot) + suffix + fileName.substr(dot);
+}
+
+// Parâmetros de um cenário estrela: servidor --(P2P)-- AP --(Wi-Fi)-- STAs
+struct WifiStarConfig
+{
+  uint32_t nSta = 4;   // clientes por célula
+  uint32_t nCells = 1; // células (AP + clientes), todas ligadas ao mesmo servidor
+  std::string cellLayout = "isolated"; // "isolated": um canal por célula; "campus": APs em grade, canal único
+  double cellSpacing = 50.0;           // campus: distância (m) entre APs vizinhos
+  double indexRange = 0.0;             // campus: alcance (m) do índice espacial; 0 = pela sensibilidade
+  std::string dataRate = "5Mbps";
+  uint32_t packetSize = 1024;
+  uint64_t maxBytes = 0; // BulkSend: 0 indica envio ilimitado
+  double splitRatio = 0.5; // SplitTraffic: fração dos clientes com o primeiro tráfego
+  bool virtualPayload = false; // OnOff/BulkSend/PacketSink trocados pelos aplicativos de bytes virtuais
+  uint16_t tcpPort = 50000;
+  uint16_t udpPort = 9;
+
+  // Tempos (em segundos)
+  double serverStart = 1.0;
+  double appStart = 2.0;
+  double startJitter = 0.0; // ms: cada cliente começa num instante sorteado em [appStart, appStart + startJitter)
+  double appStop = 30.0;
+  double simStop = 40.0;
+
+  // Parada antecipada (ver convergence-monitor.h)
+  bool drainStop = true;     // parar quando, depois de appStop, as filas esvaziarem
+  double drainQuiet = 1.0;   // s sem tráfego e com filas vazias para considerar esvaziado
+  double ciTarget = 0.0;     // meia-largura relativa do IC 95% por fluxo; 0 desliga a convergência
+  double batchLength = 1.0;  // s de cada lote das médias por lotes
+  uint32_t minBatches = 10;  // lotes antes de testar a convergência
+  double warmup = 2.0;       // s descartados depois de appStart antes do primeiro lote
+
+  // Mobilidade: posição do AP e circunferência/velocidade dos clientes
+  double apX = 25.0;
+  double apY = 25.0;
+  double radius = 10.0;
+  double speed = 2.0;
+  bool printPositions = false;
+  bool trajectories = false; // CircleMobility: posições e perda em forma fechada (TrajectoryTable)
+  bool lossCache = true;     // guarda a perda por par de nós parados (CachedPropagationLossModel)
+
+  // Enlaces
+  std::string ssid = "EquipeX";
+  std::string wifiDataMode = "HtMcs7";
+  std::string wifiControlMode = "HtMcs0";
+  std::string p2pDataRate = "100Mbps";
+  std::string p2pDelay = "2ms";
+  std::string routing = "star"; // "star": rotas estáticas por célula (StarRouting); "global": SPF do ns-3
+  // Plano de endereços (ver address-plan.h)
+  std::string wifiNetwork = "192.168.0.0"; // sub-rede Wi-Fi da célula 0; as demais em seguida
+  uint32_t wifiPrefix = 0;                 // 0: a menor que comporta nSta + 1, nunca menor que /24
+  std::string p2pNetwork = "10.1.1.0";
+  uint32_t p2pPrefix = 24;
+  bool ipv6 = false;             // também endereços IPv6 (/64 por sub-rede) e rotas estáticas IPv6
+  bool staticNeighbours = false; // caches ARP/NDISC preenchidos no Build(), sem resolução no aquecimento
+  std::string macModel = "wifi";     // "wifi": Yans/Spectrum completo; "shared": SharedMediumChannel
+  std::string mediumRate = "65Mbps"; // shared: taxa de cada transmissor
+  double mediumOverhead = 140.0;     // shared: tempo fixo por quadro (us)
+  uint32_t mediumQueue = 500;        // shared: quadros na fila de cada transmissor
+  // Filas do AP (ver airtime-fair-queue-disc.h); "default": a que o Ipv4AddressHelper instala (FqCoDel)
+  std::string apQueueDisc = "default";  // interface Wi-Fi do AP: default, fifo, codel, fq_codel, pie ou airtime
+  std::string p2pQueueDisc = "default"; // as duas pontas do enlace P2P: default, fifo, codel, fq_codel ou pie
+  std::string apMacQueue;               // fila do MAC Wi-Fi do AP por AC (ex.: "32p"); vazio: padrão do ns-3
+
+  // Saídas
+  std::string flowMonitor = "full"; // "full": FlowMonitor do ns-3; "compact": CompactFlowMonitor só nas pontas
+  std::string flowMonitorFile = "flow-monitor.xml"; // vazio: sem XML no fim da rodada
+  bool xmlHistograms = true;
+  bool xmlProbes = true;
+  double sampleInterval = 0.0; // ms de tempo simulado entre amostras; 0 desliga o amostrador
+  std::string sampleFile = "flow-samples.csv";
+  std::string sampleFormat = "csv"; // "csv" ou "columns" (binário colunar, ver flow-columns.h)
+  std::string animFile; // vazio: sem NetAnim
+  double telemetryInterval = 0.0; // ms entre amostras da telemetria dos APs; 0 desliga (ver ap-telemetry.h)
+  uint32_t telemetryWindow = 4096; // amostras de cada série guardadas em memória
+  std::string telemetryFile = "ap-telemetry.csv";
+  std::string telemetryStaFile = "sta-telemetry.csv";
+  bool transportReport = false; // imprimir vazão útil e atraso do TCP e do UDP ao fim da rodada
+  double animInterval = 0.0; // s entre posições no NetAnim, sem pacotes; 0 = NetAnim completo
+  std::string pcapPrefix;         // vazio: sem PCAP (ver pcap-tracer.h)
+  std::string pcapNodes = "ap";   // nós capturados: all, server, ap, sta e/ou ids, separados por vírgula
+  uint32_t pcapSnapLen = 128;     // bytes guardados de cada quadro
+  double pcapStart = 0.0;         // janela de captura (s); pcapStop = 0 captura até o fim
+  double pcapStop = 0.0;
+  std::string profileFile; // vazio: sem perfil por tipo de evento (ProfilingScheduler)
+  std::string scheduler = "map"; // map, heap, list, calendar ou ladder
+  std::string sinkFile = "server-sinks.csv"; // modo distribuído: bytes recebidos por sink
+
+  // Registra todos os parâmetros como opções de linha de comando (--nSta=16, --dataRate=10Mbps, ...)
+  void AddToCommandLine(CommandLine &cmd)
+  {
+    cmd.AddValue("nSta", "Número de clientes Wi-Fi por célula", nSta);
+    cmd.AddValue("nCells", "Número de células (AP + clientes) ligadas ao servidor", nCells);
+    cmd.AddValue("cellLayout", "Disposição das células: isolated ou campus (canal compartilhado)", cellLayout);
+    cmd.AddValue("cellSpacing", "Campus: distância (m) entre APs vizinhos", cellSpacing);
+    cmd.AddValue("indexRange", "Campus: alcance (m) do índice espacial (0 = pela sensibilidade)", indexRange);
+    cmd.AddValue("dataRate", "Taxa de cada cliente OnOff", dataRate);
+    cmd.AddValue("packetSize", "Tamanho do pacote da aplicação (bytes)", packetSize);
+    cmd.AddValue("maxBytes", "BulkSend: bytes a enviar por cliente (0 = ilimitado)", maxBytes);
+    cmd.AddValue("splitRatio", "Tráfego misto: fração dos clientes com o primeiro tráfego", splitRatio);
+    cmd.AddValue("virtualPayload", "Fontes e sorvedouros só com bytes virtuais (VirtualSource/VirtualSink)", virtualPayload);
+    cmd.AddValue("tcpPort", "Porta TCP do servidor", tcpPort);
+    cmd.AddValue("udpPort", "Porta UDP do servidor", udpPort);
+    cmd.AddValue("serverStart", "Início das aplicações do servidor (s)", serverStart);
+    cmd.AddValue("appStart", "Início das aplicações dos clientes (s)", appStart);
+    cmd.AddValue("startJitter", "Espalhamento (ms) do início de cada cliente depois de appStart", startJitter);
+    cmd.AddValue("appStop", "Fim das aplicações (s)", appStop);
+    cmd.AddValue("simStop", "Fim da simulação (s)", simStop);
+    cmd.AddValue("drainStop", "Parar assim que, depois de appStop, as filas esvaziarem", drainStop);
+    cmd.AddValue("drainQuiet", "Tempo (s) sem tráfego e com filas vazias para parar", drainQuiet);
+    cmd.AddValue("ciTarget", "Parar quando a meia-largura do IC 95% de cada fluxo for menor que esta fração da média (0 = desligado)", ciTarget);
+    cmd.AddValue("batchLength", "Duração (s) de cada lote das médias por lotes", batchLength);
+    cmd.AddValue("minBatches", "Lotes antes de testar a convergência", minBatches);
+    cmd.AddValue("warmup", "Tempo (s) descartado depois de appStart antes do primeiro lote", warmup);
+    cmd.AddValue("apX", "Posição X do AP (m)", apX);
+    cmd.AddValue("apY", "Posição Y do AP (m)", apY);
+    cmd.AddValue("radius", "Raio da circunferência inicial dos clientes (m)", radius);
+    cmd.AddValue("speed", "Velocidade dos clientes (m/s)", speed);
+    cmd.AddValue("trajectories", "Mobilidade por tabela de trajetórias (posição e perda em forma fechada)", trajectories);
+    cmd.AddValue("lossCache", "Guardar a perda de propagação por par de nós parados", lossCache);
+    cmd.AddValue("printPositions", "Imprimir posição e velocidade iniciais dos clientes", printPositions);
+    cmd.AddValue("ssid", "SSID da rede Wi-Fi", ssid);
+    cmd.AddValue("wifiDataMode", "Modo de dados do ConstantRateWifiManager", wifiDataMode);
+    cmd.AddValue("wifiControlMode", "Modo de controle do ConstantRateWifiManager", wifiControlMode);
+    cmd.AddValue("p2pDataRate", "Taxa do enlace AP-servidor", p2pDataRate);
+    cmd.AddValue("macModel", "Camadas Wi-Fi: wifi (completo) ou shared (meio compartilhado abstrato)", macModel);
+    cmd.AddValue("mediumRate", "Meio compartilhado: taxa de cada transmissor", mediumRate);
+    cmd.AddValue("mediumOverhead", "Meio compartilhado: tempo fixo por quadro (us)", mediumOverhead);
+    cmd.AddValue("mediumQueue", "Meio compartilhado: quadros na fila de cada transmissor", mediumQueue);
+    cmd.AddValue("apQueueDisc", "Fila da interface Wi-Fi do AP: default, fifo, codel, fq_codel, pie ou airtime", apQueueDisc);
+    cmd.AddValue("p2pQueueDisc", "Fila do enlace P2P: default, fifo, codel, fq_codel ou pie", p2pQueueDisc);
+    cmd.AddValue("apMacQueue", "Tamanho da fila do MAC Wi-Fi do AP por AC (ex.: 32p); vazio = padrão", apMacQueue);
+    cmd.AddValue("p2pDelay", "Atraso do enlace AP-servidor", p2pDelay);
+    cmd.AddValue("routing", "Rotas: star (estáticas por célula) ou global (Ipv4GlobalRoutingHelper)", routing);
+    cmd.AddValue("wifiNetwork", "Sub-rede Wi-Fi da célula 0 (as demais são as seguintes)", wifiNetwork);
+    cmd.AddValue("wifiPrefix", "Prefixo das sub-redes Wi-Fi (0 = automático pelo número de clientes)", wifiPrefix);
+    cmd.AddValue("p2pNetwork", "Sub-rede P2P da célula 0 (as demais são as seguintes)", p2pNetwork);
+    cmd.AddValue("p2pPrefix", "Prefixo das sub-redes P2P", p2pPrefix);
+    cmd.AddValue("ipv6", "Atribuir também endereços e rotas IPv6", ipv6);
+    cmd.AddValue("staticNeighbours", "Preencher os caches ARP/NDISC na montagem da rede", staticNeighbours);
+    cmd.AddValue("flowMonitor", "Monitor de fluxos: full (FlowMonitor) ou compact (só origem e destino, sem histogramas)", flowMonitor);
+    cmd.AddValue("flowMonitorFile", "Arquivo XML do FlowMonitor (vazio = não gravar)", flowMonitorFile);
+    cmd.AddValue("xmlHistograms", "Incluir os histogramas no XML do FlowMonitor", xmlHistograms);
+    cmd.AddValue("xmlProbes", "Incluir as estatísticas por sonda no XML do FlowMonitor", xmlProbes);
+    cmd.AddValue("sampleInterval", "Intervalo (ms) entre amostras por fluxo; 0 = desligado", sampleInterval);
+    cmd.AddValue("sampleFile", "Arquivo das amostras por fluxo", sampleFile);
+    cmd.AddValue("sampleFormat", "Formato das amostras: csv ou columns", sampleFormat);
+    cmd.AddValue("telemetryInterval", "Intervalo (ms) entre amostras das filas e do tempo de meio dos APs; 0 = desligado", telemetryInterval);
+    cmd.AddValue("telemetryWindow", "Amostras de telemetria guardadas em memória por série", telemetryWindow);
+    cmd.AddValue("telemetryFile", "Arquivo da telemetria por AP", telemetryFile);
+    cmd.AddValue("telemetryStaFile", "Arquivo da telemetria por cliente", telemetryStaFile);
+    cmd.AddValue("transportReport", "Imprimir vazão útil e atraso do TCP e do UDP ao fim da rodada", transportReport);
+    cmd.AddValue("animFile", "Arquivo do NetAnim (vazio = desligado)", animFile);
+    cmd.AddValue("animInterval", "NetAnim só com posições, amostradas a cada tantos s (0 = completo)", animInterval);
+    cmd.AddValue("pcapPrefix", "Prefixo dos arquivos PCAP (vazio = desligado)", pcapPrefix);
+    cmd.AddValue("pcapNodes", "Nós capturados: all, server, ap, sta e/ou ids de nós", pcapNodes);
+    cmd.AddValue("pcapSnapLen", "Bytes guardados de cada quadro no PCAP", pcapSnapLen);
+    cmd.AddValue("pcapStart", "Início da captura PCAP (s)", pcapStart);
+    cmd.AddValue("pcapStop", "Fim da captura PCAP (s; 0 = até o fim)", pcapStop);
+    cmd.AddValue("profileFile", "Perfil por tipo de evento, formato folded (vazio = desligado)", profileFile);
+    cmd.AddValue("scheduler", "Escalonador de eventos: map, heap, list, calendar ou ladder", scheduler);
+    cmd.AddValue("sinkFile", "Modo distribuído: CSV com os bytes recebidos por sink", sinkFile);
+  }
+
+  // Opções que uma variante de RunForked pode escolher: o tráfego dos clientes, a parada e as
+  // saídas. O resto já foi montado no aquecimento (nós, enlaces, mobilidade, servidores)
+  static bool IsVariantOption(const std::string &name)
+  {
+    static const std::set<std::string> names = {
+        "dataRate", "packetSize", "maxBytes", "splitRatio", "appStop", "simStop", "drainStop", "drainQuiet",
+        "ciTarget", "batchLength", "minBatches", "warmup", "flowMonitor", "flowMonitorFile", "xmlHistograms",
+        "xmlProbes", "sampleInterval", "sampleFile", "sampleFormat", "telemetryInterval", "telemetryWindow",
+        "telemetryFile", "telemetryStaFile", "transportReport", "pcapPrefix", "pcapNodes", "pcapSnapLen",
+        "pcapStart", "pcapStop"};
+    return names.count(name) > 0;
+  }
+
+  // Copia de "variant" só os campos das opções de IsVariantOption
+  void ApplyVariant(const WifiStarConfig &variant)
+  {
+    dataRate = variant.dataRate;
+    packetSize = variant.packetSize;
+    maxBytes = variant.maxBytes;
+    splitRatio = variant.splitRatio;
+    appStop = variant.appStop;
+    simStop = variant.simStop;
+    drainStop = variant.drainStop;
+    drainQuiet = variant.drainQuiet;
+    ciTarget = variant.ciTarget;
+    batchLength = variant.batchLength;
+    minBatches = variant.minBatches;
+    warmup = variant.warmup;
+    flowMonitor = variant.flowMonitor;
+    flowMonitorFile = variant.flowMonitorFile;
+    xmlHistograms = variant.xmlHistograms;
+    xmlProbes = variant.xmlProbes;
+    sampleInterval = variant.sampleInterval;
+    sampleFile = variant.sampleFile;
+    sampleFormat = variant.sampleFormat;
+    telemetryInterval = variant.telemetryInterval;
+    telemetryWindow = variant.telemetryWindow;
+    telemetryFile = variant.telemetryFile;
+    telemetryStaFile = variant.telemetryStaFile;
+    transportReport = variant.transportReport;
+    pcapPrefix = variant.pcapPrefix;
+    pcapNodes = variant.pcapNodes;
+    pcapSnapLen = variant.pcapSnapLen;
+    pcapStart = variant.pcapStart;
+    pcapStop = variant.pcapStop;
+  }
+
+  // Acrescenta "suffix" a todas as saídas ligadas (as vazias continuam desligadas), para que
+  // rodadas do mesmo programa (pontos, replicações, varreduras) não sobrescrevam os arquivos
+  void AddOutputSuffix(const std::string &suffix)
+  {
+    for (std::string *file : {&flowMonitorFile, &sampleFile, &telemetryFile, &telemetryStaFile, &animFile,
+                              &profileFile, &sinkFile}) {
+      if (!file->empty()) {
+        *file = WithSuffix(*file, suffix);
+      }
+    }
+    if (!pcapPrefix.empty()) {
+      pcapPrefix += suffix;
+    }
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Políticas de mobilidade: Install(config, apNode, wifiStaNodes)
+// ---------------------------------------------------------------------------
+
+// AP e clientes parados em grade (0,0), (2,0), ..., 8 por linha
+struct GridMobility
+{
+  static void Install(const WifiStarConfig &config, NodeContainer apNode, NodeContainer wifiStaNodes)
+  {
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "MinX", DoubleValue(0.0),
+                                  "MinY", DoubleValue(0.0),
+                                  "DeltaX", DoubleValue(2.0),
+                                  "DeltaY", DoubleValue(4.0),
+                                  "GridWidth", UintegerValue(8),
+                                  "LayoutType", StringValue("RowFirst"));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(wifiStaNodes);
+  }
+};
+
+// AP parado na origem e clientes em passeio aleatório numa área de 50 x 50 m
+struct RandomWalkMobility
+{
+  static void Install(const WifiStarConfig &config, NodeContainer apNode, NodeContainer wifiStaNodes)
+  {
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> posAllocAp = CreateObject<ListPositionAllocator>();
+    posAllocAp->Add(Vector(0.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(posAllocAp);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+
+    mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
+                                  "X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=50.0]"),
+                                  "Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=50.0]"));
+    mobility.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
+                              "Bounds", RectangleValue(Rectangle(0, 50, 0, 50)),
+                              "Speed", StringValue("ns3::ConstantRandomVariable[Constant=" +
+                                                   std::to_string(config.speed) + "]"),
+                              "Distance", DoubleValue(10.0));
+    mobility.Install(wifiStaNodes);
+  }
+};
+
+// Velocidade tangente à circunferência (clientes giram ao redor do AP)
+struct TangentialMotion
+{
+  static Vector Velocity(double angle, double x, double y, const WifiStarConfig &config)
+  {
+    return Vector(-std::sin(angle) * config.speed, std::cos(angle) * config.speed, 0.0);
+  }
+};
+
+// Velocidade radial (clientes se afastam do AP)
+struct RadialMotion
+{
+  static Vector Velocity(double angle, double x, double y, const WifiStarConfig &config)
+  {
+    double dx = x - config.apX;
+    double dy = y - config.apY;
+    double norm = std::sqrt(dx * dx + dy * dy);
+    return Vector(config.speed * dx / norm, config.speed * dy / norm, 0.0);
+  }
+};
+
+// Nó com TrajectoryMobilityModel partindo de "position" com velocidade constante
+inline void InstallTrajectory(Ptr<Node> node, const Vector &position, const Vector &velocity)
+{
+  Ptr<TrajectoryMobilityModel> mob = CreateObject<TrajectoryMobilityModel>();
+  mob->SetPosition(position);
+  mob->SetVelocity(velocity);
+  node->AggregateObject(mob);
+}
+
+// AP parado em (apX, apY) e clientes distribuídos na circunferência de raio "radius",
+// com velocidade constante dada pela política Motion. Com config.trajectories as trajetórias
+// ficam na TrajectoryTable em vez de um ConstantVelocityMobilityModel por nó.
+template <class Motion>
+struct CircleMobility
+{
+  static void Install(const WifiStarConfig &config, NodeContainer apNode, NodeContainer wifiStaNodes)
+  {
+    if (config.trajectories) {
+      InstallTrajectory(apNode.Get(0), Vector(config.apX, config.apY, 0.0), Vector(0.0, 0.0, 0.0));
+    } else {
+      MobilityHelper mobilityAp;
+      Ptr<ListPositionAllocator> posAllocAp = CreateObject<ListPositionAllocator>();
+      posAllocAp->Add(Vector(config.apX, config.apY, 0.0));
+      mobilityAp.SetPositionAllocator(posAllocAp);
+      mobilityAp.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+      mobilityAp.Install(apNode);
+
+      MobilityHelper mobilitySta;
+      mobilitySta.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+      mobilitySta.Install(wifiStaNodes);
+    }
+
+    uint32_t nSta = wifiStaNodes.GetN();
+    for (uint32_t i = 0; i < nSta; i++) {
+      double angle = 2 * M_PI * i / nSta;
+      double x = config.apX + config.radius * std::cos(angle);
+      double y = config.apY + config.radius * std::sin(angle);
+      Vector velocity = Motion::Velocity(angle, x, y, config);
+      if (config.trajectories) {
+        InstallTrajectory(wifiStaNodes.Get(i), Vector(x, y, 0.0), velocity);
+      } else {
+        Ptr<ConstantVelocityMobilityModel> mob = wifiStaNodes.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+        mob->SetPosition(Vector(x, y, 0.0));
+        mob->SetVelocity(velocity);
+      }
+
+      if (config.printPositions) {
+        std::cout << "STA " << i << " pos: (" << x << ", " << y << "), vel: ("
+                  << velocity.x << ", " << velocity.y << ")" << std::endl;
+      }
+    }
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Políticas de transporte: fábrica de sockets e porta do servidor
+// ---------------------------------------------------------------------------
+
+struct UdpTransport
+{
+  static std::string SocketFactory()
+  {
+    return "ns3::UdpSocketFactory";
+  }
+
+  static uint16_t Port(const WifiStarConfig &config)
+  {
+    return config.udpPort;
+  }
+};
+
+struct TcpTransport
+{
+  static std::string SocketFactory()
+  {
+    return "ns3::TcpSocketFactory";
+  }
+
+  static uint16_t Port(const WifiStarConfig &config)
+  {
+    return config.tcpPort;
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Políticas de tráfego: InstallServer(config, servidor) e
+// InstallClients(config, clientes, endereço do servidor)
+// ---------------------------------------------------------------------------
+
+// Sorvedouro dos tráfegos OnOff e BulkSend: PacketSink ou, com virtualPayload, VirtualSink
+template <class Transport>
+ApplicationContainer InstallSink(const WifiStarConfig &config, Ptr<Node> server)
+{
+  InetSocketAddress local(Ipv4Address::GetAny(), Transport::Port(config));
+  if (config.virtualPayload) {
+    VirtualTrafficHelper sinkHelper(VirtualSink::GetTypeId(), Transport::SocketFactory(), "Local", local);
+    return sinkHelper.Install(server);
+  }
+  PacketSinkHelper sinkHelper(Transport::SocketFactory(), local);
+  return sinkHelper.Install(server);
+}
+
+// PacketSink no servidor e OnOff sempre ligado nos clientes
+template <class Transport>
+struct OnOffTraffic
+{
+  static ApplicationContainer InstallServer(const WifiStarConfig &config, Ptr<Node> server)
+  {
+    return InstallSink<Transport>(config, server);
+  }
+
+  static ApplicationContainer InstallClients(const WifiStarConfig &config, NodeContainer clients,
+                                             Ipv4Address serverAddress)
+  {
+    if (config.virtualPayload) {
+      VirtualTrafficHelper source(VirtualSource::GetTypeId(), Transport::SocketFactory(), "Remote",
+                                  InetSocketAddress(serverAddress, Transport::Port(config)));
+      source.SetAttribute("DataRate", StringValue(config.dataRate));
+      source.SetAttribute("PacketSize", UintegerValue(config.packetSize));
+      return source.Install(clients);
+    }
+    OnOffHelper onOff(Transport::SocketFactory(), InetSocketAddress(serverAddress, Transport::Port(config)));
+    onOff.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1]"));
+    onOff.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
+    onOff.SetAttribute("DataRate", StringValue(config.dataRate));
+    onOff.SetAttribute("PacketSize", UintegerValue(config.packetSize));
+    return onOff.Install(clients);
+  }
+};
+
+// PacketSink no servidor e BulkSend nos clientes (envio o mais rápido possível)
+template <class Transport>
+struct BulkSendTraffic
+{
+  static ApplicationContainer InstallServer(const WifiStarConfig &config, Ptr<Node> server)
+  {
+    return InstallSink<Transport>(config, server);
+  }
+
+  static ApplicationContainer InstallClients(const WifiStarConfig &config, NodeContainer clients,
+                                             Ipv4Address serverAddress)
+  {
+    if (config.virtualPayload) {
+      // Sem DataRate a fonte virtual segue o BulkSend, com o SendSize padrão dele (512 bytes)
+      VirtualTrafficHelper source(VirtualSource::GetTypeId(), Transport::SocketFactory(), "Remote",
+                                  InetSocketAddress(serverAddress, Transport::Port(config)));
+      source.SetAttribute("PacketSize", UintegerValue(512));
+      source.SetAttribute("MaxBytes", UintegerValue(config.maxBytes));
+      return source.Install(clients);
+    }
+    BulkSendHelper bulkSend(Transport::SocketFactory(), InetSocketAddress(serverAddress, Transport::Port(config)));
+    bulkSend.SetAttribute("MaxBytes", UintegerValue(config.maxBytes));
+    return bulkSend.Install(clients);
+  }
+};
+
+// Servidor de eco UDP e um único pacote de eco por cliente
+struct UdpEchoTraffic
+{
+  static ApplicationContainer InstallServer(const WifiStarConfig &config, Ptr<Node> server)
+  {
+    UdpEchoServerHelper echoServer(config.udpPort);
+    return echoServer.Install(server);
+  }
+
+  static ApplicationContainer InstallClients(const WifiStarConfig &config, NodeContainer clients,
+                                             Ipv4Address serverAddress)
+  {
+    UdpEchoClientHelper echoClient(serverAddress, config.udpPort);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(1));
+    echoClient.SetAttribute("Interval", TimeValue(Seconds(1.0)));
+    echoClient.SetAttribute("PacketSize", UintegerValue(config.packetSize));
+    return echoClient.Install(clients);
+  }
+};
+
+// Os primeiros N * splitRatio clientes (metade, por padrão) com o tráfego First e o restante com Second
+template <class First, class Second>
+struct SplitTraffic
+{
+  static ApplicationContainer InstallServer(const WifiStarConfig &config, Ptr<Node> server)
+  {
+    ApplicationContainer apps;
+    apps.Add(First::InstallServer(config, server));
+    apps.Add(Second::InstallServer(config, server));
+    return apps;
+  }
+
+  static ApplicationContainer InstallClients(const WifiStarConfig &config, NodeContainer clients,
+                                             Ipv4Address serverAddress)
+  {
+    uint32_t nFirst = static_cast<uint32_t>(clients.GetN() * config.splitRatio);
+    NodeContainer firstNodes;
+    NodeContainer secondNodes;
+    for (uint32_t i = 0; i < clients.GetN(); i++) {
+      if (i < nFirst)
+        firstNodes.Add(clients.Get(i));
+      else
+        secondNodes.Add(clients.Get(i));
+    }
+    ApplicationContainer apps;
+    apps.Add(First::InstallClients(config, firstNodes, serverAddress));
+    apps.Add(Second::InstallClients(config, secondNodes, serverAddress));
+    return apps;
+  }
+};
+
+// ---------------------------------------------------------------------------
+// Cenário
+// ---------------------------------------------------------------------------
+
+// Monta a topologia servidor/AP/STAs com Wi-Fi Yans, enlace P2P e FlowMonitor. Com nCells > 1
+// o servidor atende várias células, cada uma com o seu AP, canal, SSID, clientes e enlace P2P
+// (sub-redes do AddressPlan; por padrão, célula c: 192.168.c.0/24 e 10.1.(c+1).0/24). Com
+// cellLayout = "campus" os APs ficam numa grade com lado cellSpacing, cada célula deslocada para a
+// posição do seu AP, e todas dividem um único GridSpectrumChannel, que só entrega cada quadro aos
+// vizinhos dentro do alcance.
+// Os helpers (canal, PHY, MAC, pilha, P2P) e o plano de endereços são configurados uma
+// única vez (no construtor ou em SetConfig()) e reaproveitados por todas as rodadas do mesmo
+// processo; apenas nós, dispositivos e aplicações são recriados em cada Build().
+// No modo distribuído (DistributedRun) o servidor fica no processo 0 e cada célula no processo
+// DistributedRun::CellRank(c); cada processo instala aplicações e FlowMonitor só nos seus nós.
+template <class MobilityPolicy, class TrafficPolicy>
+class WifiStarScenario
+{
+public:
+  // Nós, dispositivos e interfaces de uma célula
+  struct Cell
+  {
+    NodeContainer apNode;
+    NodeContainer staNodes;
+    NetDeviceContainer apDevice;
+    NetDeviceContainer staDevices;
+    NetDeviceContainer p2pDevices;
+    Ipv4InterfaceContainer apInterface;
+    Ipv4InterfaceContainer staInterfaces;
+    Ipv4InterfaceContainer p2pInterfaces; // índice 0: AP, índice 1: servidor
+    Ipv6InterfaceContainer apInterface6;  // só com ipv6
+    Ipv6InterfaceContainer staInterfaces6;
+    Ipv6InterfaceContainer p2pInterfaces6;
+    Ptr<SharedMediumChannel> medium;      // só com macModel = "shared"
+  };
+
+  explicit WifiStarScenario(const WifiStarConfig &config)
+  {
+    m_phy.SetPcapDataLinkType(YansWifiPhyHelper::DLT_IEEE802_11);
+    m_spectrumPhy.SetPcapDataLinkType(SpectrumWifiPhyHelper::DLT_IEEE802_11);
+    SetConfig(config);
+  }
+
+  // Troca os parâmetros usados no próximo Build() e reconfigura os helpers que dependem deles
+  void SetConfig(const WifiStarConfig &config)
+  {
+    m_config = config;
+
+    // Mesmos modelos do YansWifiChannelHelper::Default(), com a perda opcionalmente guardada
+    // por par de nós (lossCache) ou calculada pela TrajectoryTable (trajectories)
+    m_channel = YansWifiChannelHelper();
+    m_channel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    if (m_config.lossCache) {
+      m_channel.AddPropagationLoss(CachedPropagationLossModel::GetTypeId().GetName(),
+                                   "Inner", PointerValue(CreateBaseLoss()));
+    } else {
+      m_channel.AddPropagationLoss(BaseLossName());
+    }
+
+    m_wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                   "DataMode", StringValue(m_config.wifiDataMode),
+                                   "ControlMode", StringValue(m_config.wifiControlMode));
+
+    m_p2p.SetDeviceAttribute("DataRate", StringValue(m_config.p2pDataRate));
+    m_p2p.SetChannelAttribute("Delay", StringValue(m_config.p2pDelay));
+
+    m_plan = AddressPlan(Ipv4Address(m_config.wifiNetwork.c_str()), m_config.wifiPrefix,
+                         Ipv4Address(m_config.p2pNetwork.c_str()), m_config.p2pPrefix, m_config.nCells, m_config.nSta);
+  }
+
+  const WifiStarConfig &GetConfig() const
+  {
+    return m_config;
+  }
+
+  // Cria nós, dispositivos, endereços, mobilidade, aplicações e o FlowMonitor de uma rodada
+  void Build()
+  {
+    BuildNetwork();
+    InstallClientApps();
+    InstallMonitoring();
+  }
+
+  // Roda uma única vez o aquecimento (associação dos clientes, servidores já iniciados) até
+  // appStart e então cria um processo filho (fork) por variante. Cada filho instala os clientes e
+  // o FlowMonitor e continua a simulação a partir desse ponto; a memória do aquecimento é
+  // compartilhada por cópia na escrita. De cada variante só valem os campos de
+  // WifiStarConfig::IsVariantOption (tráfego dos clientes, parada e saídas): o resto é o da
+  // configuração atual. Como os servidores já param em appStop, nenhuma variante pode ir além
+  // dele. Todos os filhos partem do mesmo estado dos geradores aleatórios. Retorna o número de
+  // variantes que falharam.
+  uint32_t RunForked(const std::vector<WifiStarConfig> &variants, uint32_t jobs)
+  {
+    NS_ABORT_MSG_IF(DistributedRun::IsEnabled(), "O modo de bifurcação não funciona com MPI");
+    NS_ABORT_MSG_UNLESS(m_config.profileFile.empty(), "O perfil por evento não pode ser dividido entre variantes");
+    for (uint32_t i = 0; i < variants.size(); i++) {
+      NS_ABORT_MSG_IF(variants[i].appStop > m_config.appStop,
+                      "Variante " << i << ": appStop = " << variants[i].appStop << " s passa do fim dos servidores ("
+                                  << m_config.appStop << " s)");
+    }
+
+    BuildNetwork();
+    Simulator::Stop(Seconds(m_config.appStart));
+    Simulator::Run();
+
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < variants.size(); i++) {
+      indices.push_back(i);
+    }
+    SweepRunner runner(jobs);
+    uint32_t failures = runner.Run(indices, [this, &variants](uint32_t i) {
+      m_config.ApplyVariant(variants[i]);
+      m_config.animFile.clear(); // o NetAnim precisa acompanhar a rodada desde o início
+      InstallClientApps();
+      InstallMonitoring();
+      Run();
+      Teardown();
+      return 0;
+    });
+    Teardown();
+    return failures;
+  }
+
+  // Partes de Build(): rede (escalonador, nós, dispositivos, endereços, mobilidade, servidores e
+  // rotas), clientes e monitoração
+  void BuildNetwork()
+  {
+    ObjectFactory scheduler;
+    if (m_config.profileFile.empty()) {
+      scheduler.SetTypeId(SchedulerTypeName(m_config.scheduler));
+    } else {
+      scheduler.SetTypeId(ProfilingScheduler::GetTypeId());
+      scheduler.Set("InnerScheduler", StringValue(SchedulerTypeName(m_config.scheduler)));
+      scheduler.Set("OutputFile", StringValue(OutputName(m_config.profileFile)));
+    }
+    Simulator::SetScheduler(scheduler);
+
+    m_serverNode.Create(1, DistributedRun::ServerRank());
+    m_cells.resize(m_config.nCells);
+    for (uint32_t c = 0; c < m_cells.size(); c++) {
+      m_cells[c].apNode.Create(1, DistributedRun::CellRank(c));
+      m_cells[c].staNodes.Create(m_config.nSta, DistributedRun::CellRank(c));
+      m_apNodes.Add(m_cells[c].apNode);
+      m_wifiStaNodes.Add(m_cells[c].staNodes);
+    }
+
+    // O canal guarda os PHYs conectados a ele, então cada rodada (e cada célula) recebe um canal novo
+    bool campus = m_config.cellLayout == "campus";
+    NS_ABORT_MSG_UNLESS(campus || m_config.cellLayout == "isolated",
+                        "Disposição de células desconhecida: " << m_config.cellLayout);
+    NS_ABORT_MSG_IF(campus && DistributedRun::IsEnabled(),
+                    "O canal compartilhado do campus não pode ser dividido entre processos MPI");
+    bool shared = m_config.macModel == "shared";
+    NS_ABORT_MSG_UNLESS(shared || m_config.macModel == "wifi", "Modelo de MAC desconhecido: " << m_config.macModel);
+    NS_ABORT_MSG_IF(shared && campus, "O meio compartilhado abstrato não modela interferência entre células");
+    // O SimpleNetDevice entrega tudo ao canal na hora (DataRate 0) e a fila fica por transmissor no
+    // SharedMediumChannel, então uma fila de tráfego no AP nunca encheria
+    NS_ABORT_MSG_IF(shared && m_config.apQueueDisc != "default",
+                    "O meio compartilhado abstrato não devolve pressão à fila do AP (use --apQueueDisc=default)");
+    if (campus) {
+      m_campusChannel = CreateCampusChannel();
+      m_spectrumPhy.SetChannel(m_campusChannel);
+    }
+    for (uint32_t c = 0; c < m_cells.size(); c++) {
+      if (shared) {
+        InstallSharedMedium(m_cells[c]);
+        continue;
+      }
+      Ssid ssid = Ssid(CellSsid(c));
+      m_apMac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+      m_staMac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+      WifiPhyHelper *phy = &m_phy;
+      if (campus) {
+        phy = &m_spectrumPhy;
+      } else {
+        m_phy.SetChannel(m_channel.Create());
+      }
+      m_cells[c].apDevice = m_wifi.Install(*phy, m_apMac, m_cells[c].apNode);
+      m_cells[c].staDevices = m_wifi.Install(*phy, m_staMac, m_cells[c].staNodes);
+    }
+
+    m_stack.Install(m_serverNode);
+    m_stack.Install(m_apNodes);
+    m_stack.Install(m_wifiStaNodes);
+
+    for (uint32_t c = 0; c < m_cells.size(); c++) {
+      Cell &cell = m_cells[c];
+      Ptr<Node> ap = cell.apNode.Get(0);
+
+      // Habilitar IP Forwarding no AP (para roteamento entre interfaces)
+      ap->GetObject<Ipv4>()->SetAttribute("IpForward", BooleanValue(true));
+
+      // As filas escolhidas entram antes dos endereços, senão o Ipv4AddressHelper instala a padrão
+      InstallQueueDisc(m_config.apQueueDisc, cell.apDevice);
+      SetApMacQueue(cell.apDevice.Get(0));
+      Ipv4AddressHelper address;
+      address.SetBase(m_plan.WifiNetwork(c), m_plan.WifiMask());
+      cell.apInterface = address.Assign(cell.apDevice);
+      cell.staInterfaces = address.Assign(cell.staDevices);
+
+      cell.p2pDevices = m_p2p.Install(ap, m_serverNode.Get(0));
+      NS_ABORT_MSG_IF(m_config.p2pQueueDisc == "airtime", "A fila por tempo de meio só vale na interface Wi-Fi do AP");
+      InstallQueueDisc(m_config.p2pQueueDisc, cell.p2pDevices);
+      Ipv4AddressHelper p2pAddress;
+      p2pAddress.SetBase(m_plan.P2pNetwork(c), m_plan.P2pMask());
+      cell.p2pInterfaces = p2pAddress.Assign(cell.p2pDevices);
+
+      if (m_config.ipv6) {
+        Ipv6AddressHelper address6;
+        address6.SetBase(m_plan.WifiNetwork6(c), m_plan.Prefix6());
+        cell.apInterface6 = address6.Assign(cell.apDevice);
+        cell.staInterfaces6 = address6.Assign(cell.staDevices);
+        address6.SetBase(m_plan.P2pNetwork6(c), m_plan.Prefix6());
+        cell.p2pInterfaces6 = address6.Assign(cell.p2pDevices);
+        cell.apInterface6.SetForwarding(0, true);
+        cell.p2pInterfaces6.SetForwarding(0, true);
+      }
+
+      MobilityPolicy::Install(m_config, cell.apNode, cell.staNodes);
+      if (campus) {
+        ShiftCell(NodeContainer(cell.apNode, cell.staNodes), CellOrigin(c));
+      }
+    }
+
+    if (DistributedRun::IsLocal(m_serverNode.Get(0))) {
+      m_serverApps = TrafficPolicy::InstallServer(m_config, m_serverNode.Get(0));
+      m_serverApps.Start(Seconds(m_config.serverStart));
+      m_serverApps.Stop(Seconds(m_config.appStop));
+    }
+
+    InstallRoutes();
+    if (m_config.staticNeighbours) {
+      InstallNeighbours();
+    }
+  }
+
+  // Rotas da estrela: padrão pelo AP em cada cliente e uma rota por célula no servidor
+  void InstallRoutes()
+  {
+    if (m_config.routing == "global") {
+      Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+      return;
+    }
+    NS_ABORT_MSG_UNLESS(m_config.routing == "star", "Roteamento desconhecido: " << m_config.routing);
+    for (uint32_t c = 0; c < m_cells.size(); c++) {
+      const Cell &cell = m_cells[c];
+      Ipv4Address apAddress = cell.apInterface.GetAddress(0);
+      StarRouting::AddCell(cell.p2pDevices.Get(1), cell.p2pInterfaces.GetAddress(0), m_plan.WifiNetwork(c),
+                           m_plan.WifiMask());
+      for (uint32_t i = 0; i < cell.staDevices.GetN(); i++) {
+        StarRouting::AddStation(cell.staDevices.Get(i), apAddress);
+      }
+      if (m_config.ipv6) {
+        // O ns-3 não tem roteamento global IPv6: as rotas da estrela valem nos dois modos
+        Ipv6Address apAddress6 = cell.apInterface6.GetAddress(0, 1);
+        StarRouting::AddCell(cell.p2pDevices.Get(1), cell.p2pInterfaces6.GetAddress(0, 1), m_plan.WifiNetwork6(c),
+                             m_plan.Prefix6());
+        for (uint32_t i = 0; i < cell.staDevices.GetN(); i++) {
+          StarRouting::AddStation(cell.staDevices.Get(i), apAddress6);
+        }
+      }
+    }
+  }
+
+  // Caches ARP (e NDISC) de cada célula preenchidos de uma vez: cada cliente conhece o AP e o AP
+  // conhece todos os clientes, então o primeiro pacote de cada fluxo não espera uma resolução e o
+  // aquecimento não tem a rajada de ARP de todos os clientes ao mesmo tempo. São 2 entradas por
+  // cliente, e não as O(N²) do NeighborCacheHelper num canal compartilhado
+  void InstallNeighbours()
+  {
+    for (const Cell &cell : m_cells) {
+      Ptr<NetDevice> apDevice = cell.apDevice.Get(0);
+      for (uint32_t i = 0; i < cell.staDevices.GetN(); i++) {
+        Ptr<NetDevice> staDevice = cell.staDevices.Get(i);
+        AddressPlan::AddArpEntry(staDevice, cell.apInterface.GetAddress(0), apDevice->GetAddress());
+        AddressPlan::AddArpEntry(apDevice, cell.staInterfaces.GetAddress(i), staDevice->GetAddress());
+        if (m_config.ipv6) {
+          AddressPlan::AddNdiscEntry(staDevice, cell.apInterface6.GetAddress(0, 1), apDevice->GetAddress());
+          AddressPlan::AddNdiscEntry(apDevice, cell.staInterfaces6.GetAddress(i, 1), staDevice->GetAddress());
+        }
+      }
+    }
+  }
+
+  // Os clientes de cada célula enviam para o endereço do servidor no enlace P2P da célula. Os
+  // tempos das aplicações são relativos ao instante da instalação (diferente de zero em RunForked)
+  void InstallClientApps()
+  {
+    Time now = Simulator::Now();
+    for (const Cell &cell : m_cells) {
+      if (!DistributedRun::IsLocal(cell.apNode.Get(0))) {
+        continue;
+      }
+      ApplicationContainer apps =
+          TrafficPolicy::InstallClients(m_config, cell.staNodes, cell.p2pInterfaces.GetAddress(1));
+      apps.Start(Seconds(m_config.appStart) - now);
+      apps.Stop(Seconds(m_config.appStop) - now);
+      m_clientApps.Add(apps);
+    }
+    m_clientStart = Seconds(m_config.appStart) - now;
+    ApplyStartJitter();
+  }
+
+  // Sorteia o início de cada cliente em [appStart, appStart + startJitter), para que as
+  // aplicações (e a primeira resolução ARP de cada cliente) não disparem todas no mesmo instante.
+  // A variável é criada na primeira chamada depois do Build(), só com startJitter > 0: sem
+  // espalhamento nenhum fluxo aleatório é consumido, e cada ponto de um lote usa o RngRun dele
+  void ApplyStartJitter()
+  {
+    if (m_config.startJitter <= 0) {
+      return;
+    }
+    if (!m_startJitter) {
+      m_startJitter = CreateObject<UniformRandomVariable>();
+    }
+    for (uint32_t i = 0; i < m_clientApps.GetN(); i++) {
+      double jitter = m_startJitter->GetValue(0, m_config.startJitter);
+      m_clientApps.Get(i)->SetStartTime(m_clientStart + Seconds(jitter / 1000.0));
+    }
+  }
+
+  // FlowMonitor, amostrador, parada antecipada e NetAnim
+  void InstallMonitoring()
+  {
+    Time now = Simulator::Now();
+    if (m_config.flowMonitor == "compact") {
+      // A tag de cada pacote só é lida pelo monitor que a criou, no mesmo processo
+      NS_ABORT_MSG_IF(DistributedRun::IsEnabled(), "O monitor compacto não funciona no modo distribuído");
+      Ptr<CompactFlowMonitor> compact = Create<CompactFlowMonitor>();
+      compact->Install(NodeContainer(m_serverNode, m_wifiStaNodes));
+      m_flowRecorder = compact;
+    } else {
+      NS_ABORT_MSG_UNLESS(m_config.flowMonitor == "full", "Monitor de fluxos desconhecido: " << m_config.flowMonitor);
+      m_flowRecorder = Create<FlowMonitorRecorder>(
+          DistributedRun::IsEnabled() ? DistributedRun::LocalNodes(NodeContainer(m_serverNode, m_apNodes, m_wifiStaNodes))
+                                      : NodeContainer::GetGlobal());
+    }
+    if (m_config.sampleInterval > 0) {
+      m_sampler.reset(new FlowStatsSampler(m_flowRecorder, Seconds(m_config.sampleInterval / 1000.0),
+                                           OutputName(m_config.sampleFile), m_config.sampleFormat));
+    }
+    if (m_config.telemetryInterval > 0) {
+      m_telemetry.reset(new ApTelemetry(Seconds(m_config.telemetryInterval / 1000.0), m_config.telemetryWindow,
+                                        OutputName(m_config.telemetryFile), OutputName(m_config.telemetryStaFile)));
+      for (uint32_t c = 0; c < m_cells.size(); c++) {
+        const Cell &cell = m_cells[c];
+        if (DistributedRun::IsLocal(cell.apNode.Get(0))) {
+          m_telemetry->AddCell(c, cell.apDevice.Get(0), cell.staDevices, cell.p2pDevices.Get(0), cell.medium);
+        }
+      }
+    }
+
+    // Simulator::Stop() só para o processo que o chama, então o modo distribuído mantém simStop
+    NS_ABORT_MSG_IF(m_config.ciTarget > 0 && DistributedRun::IsEnabled(),
+                    "A parada por convergência não funciona no modo distribuído");
+    bool drain = m_config.drainStop && m_config.appStop < m_config.simStop && !DistributedRun::IsEnabled();
+    if (drain || m_config.ciTarget > 0) {
+      m_stopper.reset(new ConvergenceMonitor(m_flowRecorder, NodeContainer(m_serverNode, m_apNodes, m_wifiStaNodes)));
+      if (drain) {
+        m_stopper->EnableDrain(Seconds(m_config.appStop) - now, Seconds(m_config.drainQuiet));
+      }
+      if (m_config.ciTarget > 0) {
+        m_stopper->EnableConvergence(Seconds(m_config.appStart + m_config.warmup) - now, Seconds(m_config.batchLength),
+                                     m_config.ciTarget, m_config.minBatches);
+      }
+    }
+
+    if (!m_config.pcapPrefix.empty()) {
+      m_pcap.reset(new PcapTracer(OutputName(m_config.pcapPrefix), m_config.pcapSnapLen,
+                                  Seconds(m_config.pcapStart), Seconds(m_config.pcapStop)));
+      NodeContainer nodes = PcapNodes();
+      for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        for (uint32_t d = 0; d < nodes.Get(i)->GetNDevices(); d++) {
+          m_pcap->Install(nodes.Get(i)->GetDevice(d));
+        }
+      }
+    }
+
+    // O NetAnim não sabe lidar com nós de outros processos
+    if (!m_config.animFile.empty() && !DistributedRun::IsEnabled()) {
+      m_anim.reset(new AnimationInterface(m_config.animFile));
+      if (m_config.animInterval > 0) {
+        m_anim->SkipPacketTracing();
+        m_anim->SetMobilityPollInterval(Seconds(m_config.animInterval));
+      }
+    }
+  }
+
+  // Fixa os fluxos dos geradores aleatórios (Wi-Fi, mobilidade, pilha e aplicações) a partir de
+  // "stream", para que os números sorteados dependam só da rodada (RngRun) e não da ordem em que
+  // os objetos foram criados. Chamar entre Build() e Run(); retorna quantos fluxos foram usados.
+  int64_t AssignStreams(int64_t stream)
+  {
+    int64_t current = stream;
+    for (const Cell &cell : m_cells) {
+      if (!cell.medium) {
+        current += m_wifi.AssignStreams(cell.apDevice, current);
+        current += m_wifi.AssignStreams(cell.staDevices, current);
+      }
+    }
+    MobilityHelper mobility;
+    current += mobility.AssignStreams(NodeContainer(m_apNodes, m_wifiStaNodes), current);
+    current += m_stack.AssignStreams(NodeContainer(m_serverNode, m_apNodes, m_wifiStaNodes), current);
+    // Os inícios já sorteados no Build() são sorteados de novo com o fluxo fixo
+    if (m_config.startJitter > 0) {
+      m_startJitter->SetStream(current++);
+      ApplyStartJitter();
+    }
+    // As aplicações por último: OnOff/BulkSend e as fontes virtuais usam quantidades diferentes de
+    // fluxos, e assim os fluxos das outras camadas não mudam com --virtualPayload
+    for (const ApplicationContainer &apps : {m_serverApps, m_clientApps}) {
+      for (uint32_t i = 0; i < apps.GetN(); i++) {
+        current += apps.Get(i)->AssignStreams(current);
+      }
+    }
+    return current - stream;
+  }
+
+  // Executa a rodada montada por Build() e grava as saídas do FlowMonitor. A rodada termina em
+  // simStop ou antes, pela convergência (ciTarget) ou pelo esvaziamento das filas (drainStop)
+  void Run()
+  {
+    Simulator::Stop(Seconds(m_config.simStop) - Simulator::Now());
+    Simulator::Run();
+
+    // Esvaziadas as filas, o que não chegou não chega mais: sem isso os pacotes dos últimos
+    // maxDelay (10 s) antes do fim não entrariam em lostPackets
+    if (m_stopper && m_stopper->HasDrained()) {
+      m_flowRecorder->FlushLostPackets();
+    }
+    if (m_sampler) {
+      m_sampler->Finish();
+    }
+    if (m_telemetry) {
+      m_telemetry->Finish();
+    }
+    if (m_pcap) {
+      m_pcap->Close();
+    }
+    if (m_campusChannel) {
+      std::cout << "Canal do campus: " << m_campusChannel->GetDelivered() << " sinais entregues, "
+                << m_campusChannel->GetSkipped() << " receptores fora do alcance ignorados" << std::endl;
+    }
+    if (!m_config.flowMonitorFile.empty()) {
+      m_flowRecorder->SerializeToXmlFile(OutputName(m_config.flowMonitorFile), m_config.xmlHistograms,
+                                         m_config.xmlProbes);
+    }
+    // No modo distribuído o FlowMonitor de cada processo só vê um lado dos fluxos que cruzam o
+    // enlace P2P, então o processo do servidor também grava os bytes recebidos por sink
+    if (DistributedRun::IsEnabled() && DistributedRun::IsLocal(m_serverNode.Get(0))) {
+      WriteSinkCsv(OutputName(m_config.sinkFile));
+    }
+    if (m_config.transportReport) {
+      WriteTransportReport(std::cout);
+    }
+  }
+
+  // Bytes entregues aos sinks do servidor com a fábrica de sockets "factory" (TCP ou UDP)
+  uint64_t GetSinkRx(TypeId factory) const
+  {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < m_serverApps.GetN(); i++) {
+      Ptr<Application> app = m_serverApps.Get(i);
+      TypeIdValue protocol;
+      if (Ptr<PacketSink> sink = DynamicCast<PacketSink>(app)) {
+        sink->GetAttribute("Protocol", protocol);
+        total += protocol.Get() == factory ? sink->GetTotalRx() : 0;
+      } else if (Ptr<VirtualSink> virtualSink = DynamicCast<VirtualSink>(app)) {
+        virtualSink->GetAttribute("Protocol", protocol);
+        total += protocol.Get() == factory ? virtualSink->GetTotalRx() : 0;
+      }
+    }
+    return total;
+  }
+
+  // Vazão útil (bytes entregues às aplicações) no período de envio dos clientes, em Mbps. A rodada
+  // pode ter parado antes de appStop (ciTarget), então o período vai até o fim real do envio
+  double GetGoodputMbps(TypeId factory) const
+  {
+    double duration = std::min(Simulator::Now().GetSeconds(), m_config.appStop) - m_config.appStart;
+    return duration > 0 ? GetSinkRx(factory) * 8.0 / duration / 1e6 : 0.0;
+  }
+
+  // Vazão útil e atraso dos fluxos de dados de cada transporte, para comparar as filas do AP
+  void WriteTransportReport(std::ostream &out) const
+  {
+    struct Transport
+    {
+      const char *name;
+      uint8_t protocol;
+      uint16_t port;
+      TypeId factory;
+    };
+    const Transport transports[] = {{"TCP", 6, m_config.tcpPort, TcpSocketFactory::GetTypeId()},
+                                    {"UDP", 17, m_config.udpPort, UdpSocketFactory::GetTypeId()}};
+    for (const Transport &t : transports) {
+      FlowSummary s = SummarizeFlows(m_flowRecorder, t.protocol, t.port);
+      if (s.flows == 0) {
+        continue;
+      }
+      out << t.name << " (filas " << m_config.apQueueDisc << "/" << m_config.p2pQueueDisc << "): " << s.flows
+          << " fluxos, vazão útil " << GetGoodputMbps(t.factory) << " Mbps, Jain " << s.jainIndex
+          << ", atraso médio " << s.meanDelayMs << " ms, pior p95 " << s.p95DelayMs << " ms, PDR " << s.Pdr()
+          << std::endl;
+    }
+  }
+
+  // Encerra a rodada e descarta o estado dela; os helpers continuam prontos para o próximo Build()
+  void Teardown()
+  {
+    Simulator::Destroy();
+
+    m_anim.reset();
+    m_sampler.reset();
+    m_telemetry.reset();
+    m_stopper.reset();
+    m_pcap.reset();
+    m_flowRecorder = nullptr;
+    m_campusChannel = nullptr;
+    m_startJitter = nullptr;
+    TrajectoryTable::Get()->Clear();
+    m_serverApps = ApplicationContainer();
+    m_clientApps = ApplicationContainer();
+    m_cells.clear();
+    m_serverNode = NodeContainer();
+    m_apNodes = NodeContainer();
+    m_wifiStaNodes = NodeContainer();
+    Ipv4AddressGenerator::Reset();
+    Ipv6AddressGenerator::Reset();
+  }
+
+  // Rodada completa: Build(), Run() e Teardown(), com os fluxos fixos a partir de 0 (os mesmos
+  // sorteios com e sem --virtualPayload, que cria menos variáveis aleatórias)
+  void Execute()
+  {
+    Build();
+    AssignStreams(0);
+    Run();
+    Teardown();
+  }
+
+  Ptr<FlowRecorder> GetFlowRecorder() const
+  {
+    return m_flowRecorder;
+  }
+
+  Ptr<Ipv4FlowClassifier> GetClassifier() const
+  {
+    return m_flowRecorder->GetClassifier();
+  }
+
+  NodeContainer GetServerNode() const
+  {
+    return m_serverNode;
+  }
+
+  // APs de todas as células
+  NodeContainer GetApNodes() const
+  {
+    return m_apNodes;
+  }
+
+  // Clientes de todas as células
+  NodeContainer GetStaNodes() const
+  {
+    return m_wifiStaNodes;
+  }
+
+  const std::vector<Cell> &GetCells() const
+  {
+    return m_cells;
+  }
+
+  ApplicationContainer GetServerApps() const
+  {
+    return m_serverApps;
+  }
+
+  ApplicationContainer GetClientApps() const
+  {
+    return m_clientApps;
+  }
+
+private:
+  // A célula 0 mantém o SSID configurado; as demais recebem o sufixo "-<c>"
+  std::string CellSsid(uint32_t c) const
+  {
+    return c == 0 ? m_config.ssid : m_config.ssid + "-" + std::to_string(c);
+  }
+
+  // Substitui o Wi-Fi da célula por SimpleNetDevices num SharedMediumChannel
+  void InstallSharedMedium(Cell &cell)
+  {
+    cell.medium = CreateObject<SharedMediumChannel>();
+    cell.medium->SetAttribute("DataRate", DataRateValue(DataRate(m_config.mediumRate)));
+    cell.medium->SetAttribute("FrameOverhead", TimeValue(Seconds(m_config.mediumOverhead / 1e6)));
+    cell.medium->SetAttribute("QueueLimit", UintegerValue(m_config.mediumQueue));
+    cell.apDevice = m_simple.Install(cell.apNode, cell.medium);
+    cell.staDevices = m_simple.Install(cell.staNodes, cell.medium);
+  }
+
+  // Instala a fila "name" nos dispositivos; "default" deixa a do Ipv4AddressHelper. Em dispositivos
+  // com várias filas de transmissão (as ACs do Wi-Fi), como o TrafficControlHelper::Default(): um
+  // MqQueueDisc com uma fila filha por AC. A fila por tempo de meio fica na raiz, acima das ACs,
+  // com o mesmo modelo de quadro do meio compartilhado (mediumRate, mediumOverhead)
+  void InstallQueueDisc(const std::string &name, const NetDeviceContainer &devices)
+  {
+    if (name == "default") {
+      return;
+    }
+    std::string type = QueueDiscTypeName(name);
+    for (uint32_t i = 0; i < devices.GetN(); i++) {
+      Ptr<NetDevice> device = devices.Get(i);
+      Ptr<NetDeviceQueueInterface> queues = device->GetObject<NetDeviceQueueInterface>();
+      std::size_t nTxQueues = queues ? queues->GetNTxQueues() : 1;
+      TrafficControlHelper tch;
+      if (name == "airtime") {
+        tch.SetRootQueueDisc(type, "DataRate", DataRateValue(DataRate(m_config.mediumRate)), "FrameOverhead",
+                             TimeValue(Seconds(m_config.mediumOverhead / 1e6)));
+      } else if (nTxQueues > 1) {
+        uint16_t handle = tch.SetRootQueueDisc("ns3::MqQueueDisc");
+        TrafficControlHelper::ClassIdList classes = tch.AddQueueDiscClasses(handle, nTxQueues, "ns3::QueueDiscClass");
+        tch.AddChildQueueDiscs(handle, classes, type);
+      } else {
+        tch.SetRootQueueDisc(type);
+      }
+      tch.Install(device);
+    }
+  }
+
+  // Fila do MAC do AP menor que os 500 pacotes padrão, para que a fila escolhida em apQueueDisc
+  // (e não a do MAC) segure o excesso
+  void SetApMacQueue(Ptr<NetDevice> device)
+  {
+    if (m_config.apMacQueue.empty()) {
+      return;
+    }
+    Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(device);
+    NS_ABORT_MSG_UNLESS(wifi, "apMacQueue só vale com macModel = wifi");
+    Ptr<WifiMac> mac = wifi->GetMac();
+    if (!mac->GetQosSupported()) {
+      mac->GetTxopQueue(AC_BE_NQOS)->SetMaxSize(QueueSize(m_config.apMacQueue));
+      return;
+    }
+    for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO}) {
+      mac->GetTxopQueue(ac)->SetMaxSize(QueueSize(m_config.apMacQueue));
+    }
+  }
+
+  // Perda log-distância padrão, calculada pela TrajectoryTable quando ela está em uso
+  std::string BaseLossName() const
+  {
+    if (m_config.trajectories) {
+      return TrajectoryLogDistanceLossModel::GetTypeId().GetName();
+    }
+    return "ns3::LogDistancePropagationLossModel";
+  }
+
+  Ptr<PropagationLossModel> CreateBaseLoss() const
+  {
+    ObjectFactory factory(BaseLossName());
+    return factory.Create<PropagationLossModel>();
+  }
+
+  // Canal único do campus, com a mesma perda e atraso do YansWifiChannelHelper::Default()
+  Ptr<GridSpectrumChannel> CreateCampusChannel() const
+  {
+    Ptr<GridSpectrumChannel> channel = CreateObject<GridSpectrumChannel>();
+    Ptr<PropagationLossModel> loss = CreateBaseLoss();
+    if (m_config.lossCache) {
+      Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+      cached->SetInner(loss);
+      channel->AddPropagationLossModel(cached);
+    } else {
+      channel->AddPropagationLossModel(loss);
+    }
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+
+    // Potência de transmissão e sensibilidade padrão do WifiPhy
+    double range = m_config.indexRange > 0 ? m_config.indexRange : SensitivityRange(loss, 16.0206, -101.0);
+    channel->SetAttribute("Range", DoubleValue(range));
+    channel->SetAttribute("MaxSpeed", DoubleValue(m_config.speed));
+    return channel;
+  }
+
+  // Posição do AP da célula c na grade do campus (o mais próximo possível de um quadrado)
+  Vector CellOrigin(uint32_t c) const
+  {
+    uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(m_config.nCells))));
+    return Vector((c % columns) * m_config.cellSpacing, (c / columns) * m_config.cellSpacing, 0.0);
+  }
+
+  // Desloca os nós já posicionados pela política de mobilidade (e a área do passeio aleatório)
+  static void ShiftCell(const NodeContainer &nodes, const Vector &offset)
+  {
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+      Ptr<MobilityModel> mobility = nodes.Get(i)->GetObject<MobilityModel>();
+      Ptr<RandomWalk2dMobilityModel> walk = DynamicCast<RandomWalk2dMobilityModel>(mobility);
+      if (walk) {
+        RectangleValue bounds;
+        walk->GetAttribute("Bounds", bounds);
+        Rectangle r = bounds.Get();
+        walk->SetAttribute("Bounds", RectangleValue(Rectangle(r.xMin + offset.x, r.xMax + offset.x,
+                                                              r.yMin + offset.y, r.yMax + offset.y)));
+      }
+      mobility->SetPosition(mobility->GetPosition() + offset);
+    }
+  }
+
+  // Nós locais escolhidos por pcapNodes (papéis ou ids)
+  NodeContainer PcapNodes() const
+  {
+    std::set<uint32_t> ids;
+    for (const std::string &item : SplitList(m_config.pcapNodes)) {
+      NodeContainer role;
+      if (item == "all" || item == "server") {
+        role.Add(m_serverNode);
+      }
+      if (item == "all" || item == "ap") {
+        role.Add(m_apNodes);
+      }
+      if (item == "all" || item == "sta") {
+        role.Add(m_wifiStaNodes);
+      }
+      for (uint32_t i = 0; i < role.GetN(); i++) {
+        ids.insert(role.Get(i)->GetId());
+      }
+      if (item.find_first_not_of("0123456789") == std::string::npos) {
+        bool exists = item.size() < 10 && std::stoul(item) < NodeList::GetNNodes();
+        NS_ABORT_MSG_UNLESS(exists, "pcapNodes: não existe o nó " << item << " (ids de 0 a "
+                                                                  << NodeList::GetNNodes() - 1 << ")");
+        ids.insert(std::stoul(item));
+      } else {
+        NS_ABORT_MSG_UNLESS(item == "all" || item == "server" || item == "ap" || item == "sta",
+                            "pcapNodes: papel desconhecido " << item);
+      }
+    }
+    NodeContainer nodes;
+    for (uint32_t id : ids) {
+      nodes.Add(NodeList::GetNode(id));
+    }
+    return DistributedRun::LocalNodes(nodes);
+  }
+
+  // No modo distribuído cada processo grava arquivos próprios ("-rank<k>")
+  std::string OutputName(const std::string &fileName) const
+  {
+    if (!DistributedRun::IsEnabled()) {
+      return fileName;
+    }
+    return WithSuffix(fileName, "-rank" + std::to_string(DistributedRun::GetRank()));
+  }
+
+  void WriteSinkCsv(const std::string &fileName) const
+  {
+    std::ofstream out(fileName);
+    out << "sink,totalRxBytes\n";
+    for (uint32_t i = 0; i < m_serverApps.GetN(); i++) {
+      if (Ptr<PacketSink> sink = DynamicCast<PacketSink>(m_serverApps.Get(i))) {
+        out << i << "," << sink->GetTotalRx() << "\n";
+      } else if (Ptr<VirtualSink> virtualSink = DynamicCast<VirtualSink>(m_serverApps.Get(i))) {
+        out << i << "," << virtualSink->GetTotalRx() << "\n";
+      }
+    }
+  }
+
+  WifiStarConfig m_config;
+
+  // Reaproveitados entre rodadas
+  YansWifiChannelHelper m_channel;
+  YansWifiPhyHelper m_phy;
+  SpectrumWifiPhyHelper m_spectrumPhy;
+  WifiHelper m_wifi;
+  WifiMacHelper m_apMac;
+  WifiMacHelper m_staMac;
+  InternetStackHelper m_stack;
+  PointToPointHelper m_p2p;
+  SimpleNetDeviceHelper m_simple;
+  AddressPlan m_plan;
+  Ptr<UniformRandomVariable> m_startJitter;
+
+  // Estado de uma rodada
+  NodeContainer m_serverNode;
+  NodeContainer m_apNodes;
+  NodeContainer m_wifiStaNodes;
+  std::vector<Cell> m_cells;
+  Ptr<GridSpectrumChannel> m_campusChannel;
+  ApplicationContainer m_serverApps;
+  ApplicationContainer m_clientApps;
+  Time m_clientStart; // início dos clientes relativo à instalação
+  Ptr<FlowRecorder> m_flowRecorder;
+  std::unique_ptr<FlowStatsSampler> m_sampler;
+  std::unique_ptr<ApTelemetry> m_telemetry;
+  std::unique_ptr<ConvergenceMonitor> m_stopper;
+  std::unique_ptr<PcapTracer> m_pcap;
+  std::unique_ptr<AnimationInterface> m_anim;
+};
+
+} // namespace ns3
+
+#endif // WIFI_STAR_SCENARIO_H
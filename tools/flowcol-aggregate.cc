@@ -0,0 +1,200 @@
+// Agrega arquivos de amostras no formato colunar (common/flow-columns.h) gerados com
+// --sampleFormat=columns. Lê cada arquivo uma única vez (via mmap) e calcula, por rodada,
+// vazão, taxa de entrega (PDR), atraso e jitter médios e o índice de justiça de Jain.
+//
+// Compilação (não depende do ns-3):
+//   g++ -O2 -std=c++17 -o flowcol-aggregate tools/flowcol-aggregate.cc
+// Uso:
+//   ./flowcol-aggregate [--out=resumo.csv] [--flows=fluxos.csv] rodada1.fcol rodada2.fcol ...
+
+#include "../common/flow-columns.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+// Totais de um fluxo ao longo da rodada
+struct FlowTotals
+{
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  uint64_t txPackets = 0;
+  uint64_t rxPackets = 0;
+  uint64_t lostPackets = 0;
+  int64_t delaySumNs = 0;
+  int64_t jitterSumNs = 0;
+  int64_t firstTxNs = -1; // início do primeiro intervalo com envio
+  int64_t lastRxNs = -1;  // fim do último intervalo com recepção
+};
+
+// Métricas de uma rodada
+struct RunMetrics
+{
+  uint32_t flows = 0;
+  uint64_t txPackets = 0;
+  uint64_t rxPackets = 0;
+  double throughputMbps = 0.0;
+  double meanDelayMs = 0.0;
+  double meanJitterMs = 0.0;
+  double jainIndex = 0.0;
+
+  double Pdr() const
+  {
+    return txPackets > 0 ? static_cast<double>(rxPackets) / txPackets : 0.0;
+  }
+};
+
+static double FlowThroughputMbps(const FlowTotals &f)
+{
+  if (f.firstTxNs < 0 || f.lastRxNs <= f.firstTxNs) {
+    return 0.0;
+  }
+  return f.rxBytes * 8.0 / ((f.lastRxNs - f.firstTxNs) / 1e9) / 1e6;
+}
+
+static std::string FormatAddress(uint32_t a)
+{
+  return std::to_string(a >> 24) + "." + std::to_string((a >> 16) & 0xff) + "." +
+         std::to_string((a >> 8) & 0xff) + "." + std::to_string(a & 0xff);
+}
+
+int main(int argc, char *argv[])
+{
+  std::string outFile;
+  std::string flowsFile;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.compare(0, 6, "--out=") == 0) {
+      outFile = arg.substr(6);
+    } else if (arg.compare(0, 8, "--flows=") == 0) {
+      flowsFile = arg.substr(8);
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+  if (inputs.empty()) {
+    std::cerr << "Uso: " << argv[0] << " [--out=resumo.csv] [--flows=fluxos.csv] arquivo.fcol ..." << std::endl;
+    return 1;
+  }
+
+  std::ofstream outStream;
+  if (!outFile.empty()) {
+    outStream.open(outFile);
+  }
+  std::ostream &out = outFile.empty() ? std::cout : outStream;
+  out << "file,flows,txPackets,rxPackets,pdr,throughputMbps,meanDelayMs,meanJitterMs,jainIndex\n";
+
+  std::ofstream flowsOut;
+  if (!flowsFile.empty()) {
+    flowsOut.open(flowsFile);
+    flowsOut << "file,flowId,src,dst,srcPort,dstPort,protocol,txPackets,rxPackets,txBytes,rxBytes,"
+             << "lostPackets,throughputMbps,meanDelayMs\n";
+  }
+
+  RunMetrics mean;
+  uint32_t runs = 0;
+  int failures = 0;
+  std::vector<FlowTotals> totals;
+
+  for (const std::string &input : inputs) {
+    FlowColumnReader reader;
+    if (!reader.Open(input)) {
+      std::cerr << "Ignorando " << input << ": arquivo inválido ou incompleto" << std::endl;
+      failures++;
+      continue;
+    }
+
+    // Os identificadores de fluxo do FlowMonitor são sequenciais a partir de 1, então um
+    // vetor indexado pelo id basta
+    totals.clear();
+    int64_t bucketNs = static_cast<int64_t>(reader.GetHeader().bucketNs);
+    reader.ForEachBucket([&totals, bucketNs](const FlowColumnBucket &b) {
+      for (uint32_t i = 0; i < b.nFlows; i++) {
+        uint32_t id = b.flowId[i];
+        if (id >= totals.size()) {
+          totals.resize(id + 1);
+        }
+        FlowTotals &f = totals[id];
+        f.txBytes += b.txBytes[i];
+        f.rxBytes += b.rxBytes[i];
+        f.txPackets += b.txPackets[i];
+        f.rxPackets += b.rxPackets[i];
+        f.lostPackets += b.lostPackets[i];
+        f.delaySumNs += b.delaySumNs[i];
+        f.jitterSumNs += b.jitterSumNs[i];
+        if (b.txPackets[i] > 0 && f.firstTxNs < 0) {
+          f.firstTxNs = b.timeNs > bucketNs ? b.timeNs - bucketNs : 0;
+        }
+        if (b.rxPackets[i] > 0) {
+          f.lastRxNs = b.timeNs;
+        }
+      }
+    });
+
+    RunMetrics run;
+    double delaySumNs = 0.0;
+    double jitterSumNs = 0.0;
+    double sumX = 0.0;
+    double sumX2 = 0.0;
+    for (const FlowTotals &f : totals) {
+      if (f.txPackets == 0 && f.rxPackets == 0) {
+        continue;
+      }
+      double throughput = FlowThroughputMbps(f);
+      run.flows++;
+      run.txPackets += f.txPackets;
+      run.rxPackets += f.rxPackets;
+      run.throughputMbps += throughput;
+      delaySumNs += f.delaySumNs;
+      jitterSumNs += f.jitterSumNs;
+      sumX += throughput;
+      sumX2 += throughput * throughput;
+    }
+    if (run.rxPackets > 0) {
+      run.meanDelayMs = delaySumNs / run.rxPackets / 1e6;
+      run.meanJitterMs = jitterSumNs / run.rxPackets / 1e6;
+    }
+    if (sumX2 > 0) {
+      run.jainIndex = sumX * sumX / (run.flows * sumX2);
+    }
+
+    out << input << "," << run.flows << "," << run.txPackets << "," << run.rxPackets << "," << run.Pdr() << ","
+        << run.throughputMbps << "," << run.meanDelayMs << "," << run.meanJitterMs << "," << run.jainIndex << "\n";
+
+    if (flowsOut.is_open()) {
+      const FlowColumnFlow *flows = reader.GetFlows();
+      for (uint32_t i = 0; i < reader.GetHeader().nFlows; i++) {
+        const FlowColumnFlow &flow = flows[i];
+        FlowTotals f = flow.flowId < totals.size() ? totals[flow.flowId] : FlowTotals();
+        double delay = f.rxPackets > 0 ? f.delaySumNs / 1e6 / f.rxPackets : 0.0;
+        flowsOut << input << "," << flow.flowId << "," << FormatAddress(flow.sourceAddress) << ","
+                 << FormatAddress(flow.destinationAddress) << "," << flow.sourcePort << ","
+                 << flow.destinationPort << "," << static_cast<uint32_t>(flow.protocol) << ","
+                 << f.txPackets << "," << f.rxPackets << "," << f.txBytes << "," << f.rxBytes << ","
+                 << f.lostPackets << "," << FlowThroughputMbps(f) << "," << delay << "\n";
+      }
+    }
+
+    runs++;
+    mean.flows += run.flows;
+    mean.txPackets += run.txPackets;
+    mean.rxPackets += run.rxPackets;
+    mean.throughputMbps += run.throughputMbps;
+    mean.meanDelayMs += run.meanDelayMs;
+    mean.meanJitterMs += run.meanJitterMs;
+    mean.jainIndex += run.jainIndex;
+  }
+
+  // Última linha: média das rodadas (a PDR usa os totais de pacotes)
+  if (runs > 0) {
+    out << "mean," << static_cast<double>(mean.flows) / runs << "," << mean.txPackets / runs << ","
+        << mean.rxPackets / runs << "," << mean.Pdr() << "," << mean.throughputMbps / runs << ","
+        << mean.meanDelayMs / runs << "," << mean.meanJitterMs / runs << "," << mean.jainIndex / runs << "\n";
+  }
+  return failures == 0 ? 0 : 2;
+}